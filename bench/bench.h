@@ -0,0 +1,109 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_BENCH_H
+#define DABERS_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dabers::bench {
+
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * The number of allocations made through the global operator new so far.
+     */
+    uint64_t allocation_count() noexcept;
+
+    struct result {
+        std::string name;
+        uint64_t runs = 0;
+        double ns_per_run = 0.0;
+        double allocations_per_run = 0.0;
+        std::size_t items_per_run = 0;
+        std::size_t bytes_per_run = 0;
+    };
+
+    class state {
+    public:
+        explicit state(std::string_view name, std::chrono::nanoseconds min_time) : m_min_time{min_time} {
+            m_result.name = name;
+        }
+
+        void items_per_run(std::size_t n) noexcept { m_result.items_per_run = n; }
+        void bytes_per_run(std::size_t n) noexcept { m_result.bytes_per_run = n; }
+
+        /**
+         * Runs the body repeatedly, doubling the number of runs until a batch takes at least
+         * the minimum time, and records the time per run of that last batch.  Anything done
+         * before calling this (building the input corpus, etc.) isn't measured.
+         * @param body The code to measure; a single run should process items_per_run items.
+         */
+        template <typename F>
+        void measure(F&& body) {
+            using clock = std::chrono::steady_clock;
+            uint64_t runs = 1;
+            while (true) {
+                const auto allocs = allocation_count();
+                auto start = clock::now();
+                for (uint64_t i = 0; i < runs; ++i) {
+                    body();
+                }
+                auto elapsed = clock::now() - start;
+                if (elapsed >= m_min_time || runs >= (uint64_t{1} << 40)) {
+                    m_result.runs = runs;
+                    m_result.ns_per_run = std::chrono::duration<double, std::nano>{elapsed}.count() / static_cast<double>(runs);
+                    m_result.allocations_per_run = static_cast<double>(allocation_count() - allocs) / static_cast<double>(runs);
+                    return;
+                }
+                runs *= 2;
+            }
+        }
+
+        [[nodiscard]] const result& get_result() const noexcept { return m_result; }
+
+    private:
+        std::chrono::nanoseconds m_min_time;
+        result m_result;
+    };
+
+    using bench_fn = std::function<void(state&)>;
+
+    void register_benchmark(std::string name, bench_fn fn);
+
+    struct registration {
+        registration(std::string_view name, bench_fn fn) {
+            register_benchmark(std::string{name}, std::move(fn));
+        }
+    };
+
+} /* namespace dabers::bench */
+
+#define DABERS_BENCH_CONCAT_IMPL(a, b) a##b
+#define DABERS_BENCH_CONCAT(a, b) DABERS_BENCH_CONCAT_IMPL(a, b)
+
+/**
+ * Defines and registers a benchmark.  The body gets a dabers::bench::state& named state.
+ */
+#define DABERS_BENCHMARK(name) \
+    static void DABERS_BENCH_CONCAT(dabers_bench_fn_, __LINE__)(::dabers::bench::state& state); \
+    static const ::dabers::bench::registration DABERS_BENCH_CONCAT(dabers_bench_reg_, __LINE__){name, &DABERS_BENCH_CONCAT(dabers_bench_fn_, __LINE__)}; \
+    static void DABERS_BENCH_CONCAT(dabers_bench_fn_, __LINE__)([[maybe_unused]] ::dabers::bench::state& state)
+
+#endif //DABERS_BENCH_H
@@ -0,0 +1,195 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+//The library has its doctest cases compiled in, so we need the doctest
+//  implementation to link, but we never run them from here.
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest/doctest.h"
+
+#include "bench.h"
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace {
+
+    std::atomic<uint64_t> g_allocations{0};
+
+    /**
+     * Every replaced operator new comes through here, so every allocation is counted.
+     * @return The memory, or nullptr if there isn't any.
+     */
+    void* allocate(const std::size_t size, const std::size_t alignment) noexcept {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return std::malloc(size == 0 ? 1 : size);
+        }
+        //aligned_alloc wants the size to be a multiple of the alignment.
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    void* allocate_or_throw(const std::size_t size, const std::size_t alignment) {
+        if (void* p = allocate(size, alignment)) {
+            return p;
+        }
+        throw std::bad_alloc{};
+    }
+
+}
+
+//GCC pairs the free in each operator delete with the operator new it sees inlined at the
+//  call site, and warns that new/free don't match, though both ends are replaced here
+//  and both go to the C allocator.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) { return allocate_or_throw(size, 0); }
+void* operator new[](std::size_t size) { return allocate_or_throw(size, 0); }
+void* operator new(std::size_t size, std::align_val_t al) { return allocate_or_throw(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return allocate_or_throw(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(al)); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace dabers::bench {
+
+    namespace {
+
+        enum class output_format {
+            table,
+            csv,
+            json
+        };
+
+        std::vector<std::pair<std::string, bench_fn>>& registry() {
+            static std::vector<std::pair<std::string, bench_fn>> benches;
+            return benches;
+        }
+
+        double ns_per_item(const result& r) {
+            return r.items_per_run ? r.ns_per_run / static_cast<double>(r.items_per_run) : r.ns_per_run;
+        }
+
+        double mb_per_s(const result& r) {
+            return r.bytes_per_run ? (static_cast<double>(r.bytes_per_run) / (1024.0 * 1024.0)) / (r.ns_per_run * 1e-9) : 0.0;
+        }
+
+        void print_header(output_format fmt) {
+            switch (fmt) {
+                case output_format::table:
+                    fmt::print("{:<48} {:>10} {:>12} {:>10} {:>12}\n", "benchmark", "runs", "ns/item", "MB/s", "allocs/run");
+                    break;
+                case output_format::csv:
+                    fmt::print("name,runs,ns_per_run,ns_per_item,mb_per_s,items_per_run,bytes_per_run,allocations_per_run\n");
+                    break;
+                case output_format::json:
+                    fmt::print("[");
+                    break;
+            }
+        }
+
+        void print_result(output_format fmt, const result& r, bool first) {
+            switch (fmt) {
+                case output_format::table:
+                    fmt::print("{:<48} {:>10} {:>12.2f} {:>10.2f} {:>12.2f}\n",
+                               r.name, r.runs, ns_per_item(r), mb_per_s(r), r.allocations_per_run);
+                    break;
+                case output_format::csv:
+                    fmt::print("{},{},{:.3f},{:.3f},{:.3f},{},{},{:.3f}\n",
+                               r.name, r.runs, r.ns_per_run, ns_per_item(r), mb_per_s(r),
+                               r.items_per_run, r.bytes_per_run, r.allocations_per_run);
+                    break;
+                case output_format::json:
+                    fmt::print("{}\n  {{\"name\": \"{}\", \"runs\": {}, \"ns_per_run\": {:.3f}, \"ns_per_item\": {:.3f}, "
+                               "\"mb_per_s\": {:.3f}, \"items_per_run\": {}, \"bytes_per_run\": {}, \"allocations_per_run\": {:.3f}}}",
+                               first ? "" : ",", r.name, r.runs, r.ns_per_run, ns_per_item(r), mb_per_s(r),
+                               r.items_per_run, r.bytes_per_run, r.allocations_per_run);
+                    break;
+            }
+        }
+
+        void print_footer(output_format fmt) {
+            if (fmt == output_format::json) {
+                fmt::print("\n]\n");
+            }
+        }
+
+    }
+
+    uint64_t allocation_count() noexcept {
+        return g_allocations.load(std::memory_order_relaxed);
+    }
+
+    void register_benchmark(std::string name, bench_fn fn) {
+        registry().emplace_back(std::move(name), std::move(fn));
+    }
+
+} /* namespace dabers::bench */
+
+int main(int argc, char** argv) {
+    using namespace dabers::bench;
+    std::string_view filter;
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds{200};
+    output_format format = output_format::table;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.starts_with("--filter=")) {
+            filter = arg.substr(9);
+        }
+        else if (arg.starts_with("--min-time-ms=")) {
+            min_time = std::chrono::milliseconds{std::atoi(argv[i] + 14)};
+        }
+        else if (arg == "--format=table") {
+            format = output_format::table;
+        }
+        else if (arg == "--format=csv") {
+            format = output_format::csv;
+        }
+        else if (arg == "--format=json") {
+            format = output_format::json;
+        }
+        else {
+            fmt::print(stderr, "Usage: {} [--filter=<substring>] [--min-time-ms=<ms>] [--format=table|csv|json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    print_header(format);
+    bool first = true;
+    for (const auto& [name, fn] : registry()) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            continue;
+        }
+        state st{name, min_time};
+        fn(st);
+        print_result(format, st.get_result(), first);
+        first = false;
+    }
+    print_footer(format);
+    return 0;
+}
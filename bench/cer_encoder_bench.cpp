@@ -0,0 +1,54 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/cer_encoder.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    using namespace dabers;
+
+    /**
+     * Copies into a small reused buffer, like a socket or file buffer would, and counts
+     * the bytes.  Writes are never bigger than a segment plus its header.
+     */
+    struct counting_sink {
+        std::vector<std::byte>* buffer;
+        std::size_t bytes = 0;
+
+        void put(std::byte b) { write(&b, 1); }
+        void write(const std::byte* data, std::size_t size) {
+            const auto at = bytes % (buffer->size() - 2048);
+            std::memcpy(buffer->data() + at, data, size);
+            bytes += size;
+        }
+    };
+
+    constexpr std::size_t PAYLOAD_SIZE = 16 * 1024 * 1024;
+    constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+}
+
+DABERS_BENCHMARK("cer_encode/streamed_octet_string") {
+    //A CMS-like wrapper around a large streamed payload.
+    const std::vector<std::byte> chunk(CHUNK_SIZE, std::byte{0x5au});
+    std::vector<std::byte> buffer(CHUNK_SIZE);
+    state.bytes_per_run(PAYLOAD_SIZE);
+    state.measure([&]{
+        cer_encoder enc{counting_sink{&buffer}};
+        {
+            auto content_info = enc.constructed(universal_tags::sequence::value);
+            auto content = enc.constructed(tag{tag_class_type::context_specific, true, 0});
+            auto payload = enc.octet_string();
+            for (std::size_t i = 0; i < PAYLOAD_SIZE; i += CHUNK_SIZE) {
+                payload.write(chunk);
+            }
+        }
+        bench::do_not_optimize(enc.sink().bytes);
+    });
+}
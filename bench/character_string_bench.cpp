@@ -0,0 +1,281 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/character_string.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    using namespace dabers;
+
+    constexpr std::size_t COUNT = 10'000;
+
+    /**
+     * String contents the way a directory feed has them:  mostly short names and codes,
+     * with the occasional long description.  With long_text every string is a description
+     * of a few thousand characters, where the extra characters are rarer.
+     */
+    struct string_stream {
+        std::vector<std::byte> data;
+        std::vector<std::size_t> sizes;
+    };
+
+    string_stream make_strings(std::string_view alphabet, std::vector<std::string_view> extra = {}, const bool long_text = false) {
+        string_stream retval;
+        std::mt19937_64 rng{42};
+        const std::size_t count = long_text ? COUNT / 10 : COUNT;
+        const auto extra_rate = long_text ? 64u : 8u;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto pick = rng() % 16;
+            const std::size_t len = long_text ? 1000 + rng() % 3000 : pick == 0 ? 100 + rng() % 400 : pick < 4 ? 2 : 4 + rng() % 40;
+            std::string s;
+            while (s.size() < len) {
+                if (!extra.empty() && rng() % extra_rate == 0) {
+                    s += extra[rng() % extra.size()];
+                }
+                else {
+                    s.push_back(alphabet[rng() % alphabet.size()]);
+                }
+            }
+            for (auto c : s) {
+                retval.data.push_back(static_cast<std::byte>(c));
+            }
+            retval.sizes.push_back(s.size());
+        }
+        return retval;
+    }
+
+    constexpr std::string_view PRINTABLE = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 '()+,-./:=?";
+    constexpr std::string_view IA5 = "abcdefghijklmnopqrstuvwxyz0123456789@._-+";
+
+    /**
+     * A character at a time, for comparison.
+     */
+    bool loop_printable(std::span<const std::byte> s) {
+        return std::all_of(s.begin(), s.end(), [](std::byte b){
+            const auto c = std::to_integer<char>(b);
+            return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                   PRINTABLE.substr(62).find(c) != std::string_view::npos;
+        });
+    }
+
+    bool loop_utf8(std::span<const std::byte> s) {
+        std::size_t i = 0;
+        while (i < s.size()) {
+            const auto c = std::to_integer<unsigned int>(s[i]);
+            std::size_t n = 0;
+            uint32_t cp = 0;
+            if (c < 0x80u) {
+                ++i;
+                continue;
+            }
+            else if ((c & 0xe0u) == 0xc0u) {
+                n = 1;
+                cp = c & 0x1fu;
+            }
+            else if ((c & 0xf0u) == 0xe0u) {
+                n = 2;
+                cp = c & 0x0fu;
+            }
+            else if ((c & 0xf8u) == 0xf0u) {
+                n = 3;
+                cp = c & 0x07u;
+            }
+            else {
+                return false;
+            }
+            if (i + n >= s.size()) {
+                return false;
+            }
+            for (std::size_t j = 1; j <= n; ++j) {
+                const auto d = std::to_integer<unsigned int>(s[i + j]);
+                if ((d & 0xc0u) != 0x80u) {
+                    return false;
+                }
+                cp = (cp << 6) | (d & 0x3fu);
+            }
+            constexpr uint32_t MIN[] = {0, 0x80, 0x800, 0x10000};
+            if (cp < MIN[n] || cp > 0x10ffffu || (cp >= 0xd800u && cp <= 0xdfffu)) {
+                return false;
+            }
+            i += n + 1;
+        }
+        return true;
+    }
+
+    template <typename F>
+    void bench_stream(bench::state& state, const string_stream& s, F f) {
+        state.items_per_run(s.sizes.size());
+        state.bytes_per_run(s.data.size());
+        state.measure([&]{
+            const std::byte* cur = s.data.data();
+            std::size_t valid = 0;
+            for (auto n : s.sizes) {
+                valid += f(std::span{cur, n});
+                cur += n;
+            }
+            bench::do_not_optimize(valid);
+        });
+    }
+
+}
+
+DABERS_BENCHMARK("strings/printable/is_valid_string") {
+    bench_stream(state, make_strings(PRINTABLE), [](std::span<const std::byte> s){
+        return is_valid_string(string_type::printable, s);
+    });
+}
+
+DABERS_BENCHMARK("strings/printable/loop_reference") {
+    bench_stream(state, make_strings(PRINTABLE), &loop_printable);
+}
+
+DABERS_BENCHMARK("strings/ia5/is_valid_string") {
+    bench_stream(state, make_strings(IA5), [](std::span<const std::byte> s){
+        return is_valid_string(string_type::ia5, s);
+    });
+}
+
+DABERS_BENCHMARK("strings/utf8/is_valid_string") {
+    bench_stream(state, make_strings(PRINTABLE, {"\xc3\xa9", "\xc3\xbc", "\xe2\x82\xac", "\xe6\x97\xa5\xe6\x9c\xac"}), [](std::span<const std::byte> s){
+        return is_valid_string(string_type::utf8, s);
+    });
+}
+
+DABERS_BENCHMARK("strings/utf8/loop_reference") {
+    bench_stream(state, make_strings(PRINTABLE, {"\xc3\xa9", "\xc3\xbc", "\xe2\x82\xac", "\xe6\x97\xa5\xe6\x9c\xac"}), &loop_utf8);
+}
+
+namespace {
+
+    /**
+     * A string stream as big-endian code units of the given width.
+     */
+    string_stream to_units(const string_stream& utf8, const std::size_t width) {
+        string_stream retval;
+        const std::byte* cur = utf8.data.data();
+        for (auto n : utf8.sizes) {
+            std::vector<std::byte> units(max_universal_size_of_utf8(n));
+            std::size_t written = 0;
+            const std::string_view s{reinterpret_cast<const char*>(cur), n};
+            if (width == 2) {
+                try_utf8_to_bmp(s, units, written);
+            }
+            else {
+                try_utf8_to_universal(s, units, written);
+            }
+            retval.data.insert(retval.data.end(), units.begin(), units.begin() + static_cast<std::ptrdiff_t>(written));
+            retval.sizes.push_back(written);
+            cur += n;
+        }
+        return retval;
+    }
+
+    /**
+     * A character at a time, for comparison.
+     */
+    std::size_t loop_bmp_to_utf8(std::span<const std::byte> s, char* o) {
+        char* const begin = o;
+        for (std::size_t i = 0; i + 1 < s.size(); i += 2) {
+            const auto cp = (std::to_integer<uint32_t>(s[i]) << 8) | std::to_integer<uint32_t>(s[i + 1]);
+            if (cp < 0x80u) {
+                *o++ = static_cast<char>(cp);
+            }
+            else if (cp < 0x800u) {
+                *o++ = static_cast<char>(0xc0u | (cp >> 6));
+                *o++ = static_cast<char>(0x80u | (cp & 0x3fu));
+            }
+            else {
+                *o++ = static_cast<char>(0xe0u | (cp >> 12));
+                *o++ = static_cast<char>(0x80u | ((cp >> 6) & 0x3fu));
+                *o++ = static_cast<char>(0x80u | (cp & 0x3fu));
+            }
+        }
+        return static_cast<std::size_t>(o - begin);
+    }
+
+    const string_stream& mixed_utf8() {
+        static const auto s = make_strings(PRINTABLE, {"\xc3\xa9", "\xc3\xbc", "\xe2\x82\xac", "\xe6\x97\xa5\xe6\x9c\xac"});
+        return s;
+    }
+
+    const string_stream& long_utf8() {
+        static const auto s = make_strings(PRINTABLE, {"\xc3\xa9", "\xc3\xbc", "\xe2\x82\xac", "\xe6\x97\xa5\xe6\x9c\xac"}, true);
+        return s;
+    }
+
+}
+
+DABERS_BENCHMARK("strings/bmp/try_bmp_to_utf8") {
+    std::vector<char> out(max_utf8_size_of_bmp(4096));
+    bench_stream(state, to_units(mixed_utf8(), 2), [&](std::span<const std::byte> s){
+        std::size_t written = 0;
+        try_bmp_to_utf8(s, out, written);
+        return written;
+    });
+}
+
+DABERS_BENCHMARK("strings/bmp/loop_reference") {
+    std::vector<char> out(max_utf8_size_of_bmp(4096));
+    bench_stream(state, to_units(mixed_utf8(), 2), [&](std::span<const std::byte> s){
+        return loop_bmp_to_utf8(s, out.data());
+    });
+}
+
+DABERS_BENCHMARK("strings/bmp/ascii/try_bmp_to_utf8") {
+    std::vector<char> out(max_utf8_size_of_bmp(4096));
+    bench_stream(state, to_units(make_strings(PRINTABLE), 2), [&](std::span<const std::byte> s){
+        std::size_t written = 0;
+        try_bmp_to_utf8(s, out, written);
+        return written;
+    });
+}
+
+DABERS_BENCHMARK("strings/bmp/ascii/loop_reference") {
+    std::vector<char> out(max_utf8_size_of_bmp(4096));
+    bench_stream(state, to_units(make_strings(PRINTABLE), 2), [&](std::span<const std::byte> s){
+        return loop_bmp_to_utf8(s, out.data());
+    });
+}
+
+DABERS_BENCHMARK("strings/bmp/long/try_bmp_to_utf8") {
+    std::vector<char> out(max_utf8_size_of_bmp(8192));
+    bench_stream(state, to_units(long_utf8(), 2), [&](std::span<const std::byte> s){
+        std::size_t written = 0;
+        try_bmp_to_utf8(s, out, written);
+        return written;
+    });
+}
+
+DABERS_BENCHMARK("strings/bmp/long/loop_reference") {
+    std::vector<char> out(max_utf8_size_of_bmp(8192));
+    bench_stream(state, to_units(long_utf8(), 2), [&](std::span<const std::byte> s){
+        return loop_bmp_to_utf8(s, out.data());
+    });
+}
+
+DABERS_BENCHMARK("strings/bmp/try_utf8_to_bmp") {
+    std::vector<std::byte> out(max_bmp_size_of_utf8(4096));
+    bench_stream(state, mixed_utf8(), [&](std::span<const std::byte> s){
+        std::size_t written = 0;
+        try_utf8_to_bmp({reinterpret_cast<const char*>(s.data()), s.size()}, out, written);
+        return written;
+    });
+}
+
+DABERS_BENCHMARK("strings/universal/try_universal_to_utf8") {
+    std::vector<char> out(max_utf8_size_of_universal(8192));
+    bench_stream(state, to_units(mixed_utf8(), 4), [&](std::span<const std::byte> s){
+        std::size_t written = 0;
+        try_universal_to_utf8(s, out, written);
+        return written;
+    });
+}
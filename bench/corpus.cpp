@@ -0,0 +1,273 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "corpus.h"
+
+#include "dabers/header.h"
+#include "dabers/length.h"
+#include "dabers/tag.h"
+
+#include <initializer_list>
+#include <random>
+#include <string>
+
+namespace dabers::bench {
+
+    namespace {
+
+        using bytes = std::vector<std::byte>;
+
+        constexpr auto UNIV = tag_class_type::universal;
+        constexpr auto APP = tag_class_type::application;
+        constexpr auto CTX = tag_class_type::context_specific;
+
+        bytes tlv(const tag& t, const bytes& contents) {
+            bytes retval;
+            retval.reserve(contents.size() + max_encoded_tag_size + max_encoded_length_size);
+            write_tag(t, vector_sink{retval});
+            write_length(der{}, t.constructed, contents.size(), vector_sink{retval});
+            retval.insert(retval.end(), contents.begin(), contents.end());
+            return retval;
+        }
+
+        bytes tlv_indefinite(tag t, const bytes& contents) {
+            t.constructed = true;
+            bytes retval;
+            write_tag(t, vector_sink{retval});
+            write_length(cer{}, true, contents.size(), vector_sink{retval});
+            retval.insert(retval.end(), contents.begin(), contents.end());
+            retval.push_back(std::byte{0});
+            retval.push_back(std::byte{0});
+            return retval;
+        }
+
+        bytes cat(std::initializer_list<bytes> parts) {
+            bytes retval;
+            for (const auto& p : parts) {
+                retval.insert(retval.end(), p.begin(), p.end());
+            }
+            return retval;
+        }
+
+        bytes seq(std::initializer_list<bytes> parts) {
+            return tlv({UNIV, true, 16}, cat(parts));
+        }
+
+        bytes set(std::initializer_list<bytes> parts) {
+            return tlv({UNIV, true, 17}, cat(parts));
+        }
+
+        bytes raw(std::initializer_list<unsigned int> v) {
+            bytes retval;
+            for (auto b : v) {
+                retval.push_back(static_cast<std::byte>(b));
+            }
+            return retval;
+        }
+
+        bytes str(std::string_view s) {
+            bytes retval;
+            for (auto c : s) {
+                retval.push_back(static_cast<std::byte>(c));
+            }
+            return retval;
+        }
+
+        bytes random_bytes(std::mt19937_64& rng, std::size_t n) {
+            bytes retval(n);
+            for (auto& b : retval) {
+                b = static_cast<std::byte>(rng());
+            }
+            return retval;
+        }
+
+        std::string random_text(std::mt19937_64& rng, std::size_t min, std::size_t max) {
+            static constexpr std::string_view chars = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 ";
+            std::string retval(min + rng() % (max - min + 1), ' ');
+            for (auto& c : retval) {
+                c = chars[rng() % chars.size()];
+            }
+            return retval;
+        }
+
+        bytes integer(uint64_t v) {
+            bytes contents;
+            do {
+                contents.insert(contents.begin(), static_cast<std::byte>(v & 0xffu));
+                v >>= 8;
+            } while (v != 0);
+            if ((contents.front() & std::byte{0x80u}) != std::byte{0}) {
+                contents.insert(contents.begin(), std::byte{0});
+            }
+            return tlv({UNIV, false, 2}, contents);
+        }
+
+        bytes oid(std::initializer_list<unsigned int> encoded) {
+            return tlv({UNIV, false, 6}, raw(encoded));
+        }
+
+        bytes null() {
+            return tlv({UNIV, false, 5}, {});
+        }
+
+        bytes name(std::mt19937_64& rng) {
+            //C, ST, L, O, OU, CN
+            static constexpr unsigned int attr_types[] = {6, 8, 7, 10, 11, 3};
+            bytes rdns;
+            for (auto t : attr_types) {
+                auto rdn = set({seq({oid({0x55u, 0x04u, t}), tlv({UNIV, false, 19}, str(random_text(rng, 2, 24)))})});
+                rdns.insert(rdns.end(), rdn.begin(), rdn.end());
+            }
+            return tlv({UNIV, true, 16}, rdns);
+        }
+
+        bytes x509_certificate(std::mt19937_64& rng) {
+            auto sig_alg = seq({oid({0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x01u, 0x0bu}), null()});
+            bytes extensions;
+            for (int i = 0; i < 6; ++i) {
+                auto ext = seq({oid({0x55u, 0x1du, static_cast<unsigned int>(14 + i)}),
+                                i % 3 == 0 ? tlv({UNIV, false, 1}, raw({0xffu})) : bytes{},
+                                tlv({UNIV, false, 4}, random_bytes(rng, 20 + rng() % 40))});
+                extensions.insert(extensions.end(), ext.begin(), ext.end());
+            }
+            auto tbs = seq({tlv({CTX, true, 0}, integer(2)),
+                            tlv({UNIV, false, 2}, cat({raw({0x01u}), random_bytes(rng, 15)})),
+                            sig_alg,
+                            name(rng),
+                            seq({tlv({UNIV, false, 23}, str("220101000000Z")), tlv({UNIV, false, 23}, str("320101000000Z"))}),
+                            name(rng),
+                            seq({seq({oid({0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x01u, 0x01u}), null()}),
+                                 tlv({UNIV, false, 3}, cat({raw({0x00u}), random_bytes(rng, 270)}))}),
+                            tlv({CTX, true, 3}, tlv({UNIV, true, 16}, extensions))});
+            return seq({tbs, sig_alg, tlv({UNIV, false, 3}, cat({raw({0x00u}), random_bytes(rng, 256)}))});
+        }
+
+        bytes snmp_response(std::mt19937_64& rng) {
+            bytes varbinds;
+            const auto count = 4 + rng() % 12;
+            for (std::size_t i = 0; i < count; ++i) {
+                bytes value;
+                switch (rng() % 3) {
+                    case 0: value = integer(rng() % 100'000); break;
+                    case 1: value = tlv({UNIV, false, 4}, str(random_text(rng, 4, 40))); break;
+                    default: value = tlv({APP, false, 1}, raw({0x12u, 0x34u, 0x56u})); break;
+                }
+                auto vb = seq({oid({0x2bu, 0x06u, 0x01u, 0x02u, 0x01u, 0x02u, 0x02u, 0x01u,
+                                    static_cast<unsigned int>(1 + rng() % 20), static_cast<unsigned int>(1 + i)}),
+                               value});
+                varbinds.insert(varbinds.end(), vb.begin(), vb.end());
+            }
+            auto pdu = tlv({CTX, true, 2}, cat({integer(rng() % 0x7fffffff), integer(0), integer(0),
+                                                tlv({UNIV, true, 16}, varbinds)}));
+            return seq({integer(1), tlv({UNIV, false, 4}, str("public")), pdu});
+        }
+
+        bytes ldap_entry(std::mt19937_64& rng, uint64_t message_id) {
+            static constexpr std::string_view attr_names[] = {
+                    "cn", "sn", "givenName", "mail", "telephoneNumber", "objectClass", "memberOf", "description"
+            };
+            bytes attrs;
+            for (auto a : attr_names) {
+                bytes values;
+                const auto count = 1 + rng() % 3;
+                for (std::size_t i = 0; i < count; ++i) {
+                    auto v = tlv({UNIV, false, 4}, str(random_text(rng, 3, 60)));
+                    values.insert(values.end(), v.begin(), v.end());
+                }
+                auto attr = seq({tlv({UNIV, false, 4}, str(a)), tlv({UNIV, true, 17}, values)});
+                attrs.insert(attrs.end(), attr.begin(), attr.end());
+            }
+            auto dn = "cn=" + random_text(rng, 5, 20) + ",ou=people,dc=example,dc=com";
+            return seq({integer(message_id),
+                        tlv({APP, true, 4}, cat({tlv({UNIV, false, 4}, str(dn)), tlv({UNIV, true, 16}, attrs)}))});
+        }
+
+        bytes cdr_record(std::mt19937_64& rng) {
+            bytes fields;
+            for (unsigned int i = 0; i < 24; ++i) {
+                bytes f;
+                if (i % 6 == 5) {
+                    //A nested group of fields, some with extended tag numbers.
+                    f = tlv_indefinite({CTX, true, i},
+                                       cat({tlv({CTX, false, 0}, random_bytes(rng, 4)),
+                                            tlv({CTX, false, 1}, random_bytes(rng, 8)),
+                                            tlv({CTX, false, 100 + i}, random_bytes(rng, 2))}));
+                }
+                else if (i % 4 == 0) {
+                    //Timestamps.
+                    f = tlv({CTX, false, i}, random_bytes(rng, 9));
+                }
+                else {
+                    f = tlv({CTX, false, i}, random_bytes(rng, 1 + rng() % 12));
+                }
+                fields.insert(fields.end(), f.begin(), f.end());
+            }
+            auto ext = tlv({CTX, false, 200}, random_bytes(rng, 6));
+            fields.insert(fields.end(), ext.begin(), ext.end());
+            return tlv_indefinite({APP, true, 1}, fields);
+        }
+
+        std::size_t count_elements(const bytes& data, rules r) {
+            //Descending into every constructed element visits every header in order.
+            std::size_t retval = 0;
+            const std::byte* cur = data.data();
+            const std::byte* const end = data.data() + data.size();
+            tlv_header h;
+            while (cur != end && try_parse_header(r, cur, end, h) == decode_error::none) {
+                if (!h.id.constructed) {
+                    cur += h.contents.size();
+                }
+                ++retval;
+            }
+            return retval;
+        }
+
+        template <typename F>
+        corpus make_corpus(std::string_view name, rules r, std::size_t records, F&& make_record) {
+            corpus retval;
+            retval.name = name;
+            retval.encoding = r;
+            retval.records = records;
+            for (std::size_t i = 0; i < records; ++i) {
+                auto rec = make_record(i);
+                retval.data.insert(retval.data.end(), rec.begin(), rec.end());
+            }
+            retval.elements = count_elements(retval.data, r);
+            return retval;
+        }
+
+    }
+
+    corpus make_x509_corpus(const std::size_t records) {
+        std::mt19937_64 rng{509};
+        return make_corpus("x509", rules::der, records, [&rng](std::size_t){ return x509_certificate(rng); });
+    }
+
+    corpus make_snmp_corpus(const std::size_t records) {
+        std::mt19937_64 rng{161};
+        return make_corpus("snmp", rules::ber, records, [&rng](std::size_t){ return snmp_response(rng); });
+    }
+
+    corpus make_ldap_corpus(const std::size_t records) {
+        std::mt19937_64 rng{389};
+        return make_corpus("ldap", rules::ber, records, [&rng](std::size_t i){ return ldap_entry(rng, i + 1); });
+    }
+
+    corpus make_cdr_corpus(const std::size_t records) {
+        std::mt19937_64 rng{32298};
+        return make_corpus("cdr", rules::ber, records, [&rng](std::size_t){ return cdr_record(rng); });
+    }
+
+    const std::vector<corpus>& standard_corpora() {
+        //Roughly 1 MiB each.
+        static const std::vector<corpus> corpora{
+                make_x509_corpus(1'000),
+                make_snmp_corpus(3'500),
+                make_ldap_corpus(2'500),
+                make_cdr_corpus(5'000)
+        };
+        return corpora;
+    }
+
+} /* namespace dabers::bench */
@@ -0,0 +1,58 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_BENCH_CORPUS_H
+#define DABERS_BENCH_CORPUS_H
+
+#include "dabers/rules.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace dabers::bench {
+
+    /**
+     * A buffer of concatenated top-level records shaped like a real kind of traffic.
+     */
+    struct corpus {
+        std::string_view name;
+        rules encoding = rules::ber;
+        std::vector<std::byte> data;
+        std::size_t records = 0;
+        /**
+         * Every TLV in the data, including end-of-contents markers.
+         */
+        std::size_t elements = 0;
+    };
+
+    /**
+     * X.509 v3 certificates (DER), with RDN sequences, RSA keys and a handful of extensions.
+     */
+    corpus make_x509_corpus(std::size_t records);
+
+    /**
+     * SNMPv2c GetResponse PDUs (BER, definite lengths), each with a list of varbinds.
+     */
+    corpus make_snmp_corpus(std::size_t records);
+
+    /**
+     * LDAP SearchResultEntry messages (BER, definite lengths) with multi-valued attributes.
+     */
+    corpus make_ldap_corpus(std::size_t records);
+
+    /**
+     * Telecom call detail records (BER, indefinite lengths) with many context specific
+     * fields, some of them with tag numbers needing the extended form.
+     */
+    corpus make_cdr_corpus(std::size_t records);
+
+    /**
+     * All of the above, each sized to roughly the same number of bytes.
+     */
+    const std::vector<corpus>& standard_corpora();
+
+} /* namespace dabers::bench */
+
+#endif //DABERS_BENCH_CORPUS_H
@@ -0,0 +1,283 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+#include "corpus.h"
+
+#include "dabers/header.h"
+#include "dabers/length.h"
+#include "dabers/parallel.h"
+#include "dabers/push_parser.h"
+#include "dabers/skip.h"
+#include "dabers/tag.h"
+#include "dabers/tape.h"
+#include "dabers/tlv_view.h"
+#include "dabers/tree.h"
+#include "dabers/validate.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace {
+
+    using namespace dabers;
+    using bench::corpus;
+
+    /**
+     * Visits every header in order by descending into each constructed element instead of
+     * skipping its contents.  End-of-contents octets show up as universal 0 elements.
+     */
+    std::size_t walk_parse_tag_length(const corpus& c) {
+        std::size_t count = 0;
+        const std::byte* cur = c.data.data();
+        const std::byte* const end = c.data.data() + c.data.size();
+        while (cur != end) {
+            auto t = parse_tag(cur, end);
+            auto len = parse_length(c.encoding, t.constructed, cur, end);
+            if (!t.constructed) {
+                cur += *len;
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    std::size_t walk_parse_header(const corpus& c) {
+        std::size_t count = 0;
+        const std::byte* cur = c.data.data();
+        const std::byte* const end = c.data.data() + c.data.size();
+        tlv_header h;
+        while (cur != end && try_parse_header(c.encoding, cur, end, h) == decode_error::none) {
+            if (!h.id.constructed) {
+                cur += h.contents.size();
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    std::size_t walk_view(const tlv_view& v) {
+        std::size_t count = 0;
+        for (const auto& e : v) {
+            count += e.indefinite() ? 2 : 1;
+            if (e.constructed()) {
+                count += walk_view(e.children());
+            }
+        }
+        return count;
+    }
+
+    struct counting_handler {
+        std::size_t elements = 0;
+        std::size_t content_bytes = 0;
+
+        void on_element(const tlv_header&, std::size_t) { ++elements; }
+        void on_content(std::span<const std::byte> data) { content_bytes += data.size(); }
+        void on_end(std::size_t) {}
+    };
+
+    struct header_record {
+        tag t;
+        uint64_t length = 0;
+        bool indefinite = false;
+    };
+
+    std::vector<header_record> collect_headers(const corpus& c) {
+        std::vector<header_record> retval;
+        const std::byte* cur = c.data.data();
+        const std::byte* const end = c.data.data() + c.data.size();
+        tlv_header h;
+        while (cur != end && try_parse_header(c.encoding, cur, end, h) == decode_error::none) {
+            if (!h.id.constructed) {
+                cur += h.contents.size();
+            }
+            retval.push_back({h.id, h.length.value_or(0), h.indefinite()});
+        }
+        return retval;
+    }
+
+    constexpr std::size_t CHUNK_SIZE = 1460;
+
+    using corpus_bench_fn = void (*)(bench::state&, const corpus&);
+
+    void bench_parse_tag_length(bench::state& state, const corpus& c) {
+        state.measure([&]{ bench::do_not_optimize(walk_parse_tag_length(c)); });
+    }
+
+    void bench_parse_header(bench::state& state, const corpus& c) {
+        state.measure([&]{ bench::do_not_optimize(walk_parse_header(c)); });
+    }
+
+    void bench_tlv_view(bench::state& state, const corpus& c) {
+        state.measure([&]{ bench::do_not_optimize(walk_view(tlv_view{c.data, c.encoding})); });
+    }
+
+    void bench_tape(bench::state& state, const corpus& c) {
+        tape t;
+        state.measure([&]{
+            t.build(c.data, c.encoding);
+            bench::do_not_optimize(t.size());
+        });
+    }
+
+    void bench_validate(bench::state& state, const corpus& c) {
+        state.measure([&]{
+            const auto r = c.encoding == rules::der ? validate<der>(c.data) : validate<ber>(c.data);
+            bench::do_not_optimize(r.error);
+        });
+    }
+
+    void bench_tree(bench::state& state, const corpus& c) {
+        node_arena arena;
+        tree t;
+        state.measure([&]{
+            arena.reset();
+            tree::decode(arena, c.data, c.encoding, t);
+            bench::do_not_optimize(t.size());
+        });
+    }
+
+    void bench_scan_records(bench::state& state, const corpus& c) {
+        std::vector<std::span<const std::byte>> records;
+        state.measure([&]{
+            records.clear();
+            scan_records(c.data, c.encoding, records);
+            bench::do_not_optimize(records.size());
+        });
+    }
+
+    /**
+     * Scans for the records and then decodes each one into a tree on every hardware thread,
+     * collecting the node counts in order.
+     */
+    void bench_parallel_tree(bench::state& state, const corpus& c) {
+        static thread_pool pool;
+        std::vector<std::span<const std::byte>> records;
+        state.measure([&]{
+            records.clear();
+            scan_records(c.data, c.encoding, records);
+            auto sizes = parallel_decode(pool, records, [&](std::size_t, std::span<const std::byte> record){
+                thread_local node_arena arena;
+                arena.reset();
+                tree t;
+                tree::decode(arena, record, c.encoding, t);
+                return t.size();
+            });
+            bench::do_not_optimize(sizes.data());
+        });
+    }
+
+    /**
+     * Skips every top-level record the way the cursor used to, parsing every header
+     * inside indefinite length elements with try_parse_header.
+     */
+    std::size_t header_walk_skip(const corpus& c) {
+        std::size_t count = 0;
+        const std::byte* cur = c.data.data();
+        const std::byte* const end = c.data.data() + c.data.size();
+        tlv_header h;
+        while (cur != end && try_parse_header(c.encoding, cur, end, h) == decode_error::none) {
+            if (!h.indefinite()) {
+                cur += h.contents.size();
+            }
+            else {
+                std::size_t depth = 1;
+                while (depth > 0 && end - cur >= 2) {
+                    if (cur[0] == std::byte{0} && cur[1] == std::byte{0}) {
+                        --depth;
+                        cur += 2;
+                    }
+                    else if (try_parse_header(c.encoding, cur, end, h) != decode_error::none) {
+                        return count;
+                    }
+                    else if (h.indefinite()) {
+                        ++depth;
+                    }
+                    else {
+                        cur += h.contents.size();
+                    }
+                }
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    std::size_t skip_records(const corpus& c) {
+        std::size_t count = 0;
+        const std::byte* cur = c.data.data();
+        const std::byte* const end = c.data.data() + c.data.size();
+        while (cur != end && skip_element(c.encoding, cur, end) == decode_error::none) {
+            ++count;
+        }
+        return count;
+    }
+
+    void bench_skip_element(bench::state& state, const corpus& c) {
+        state.measure([&]{ bench::do_not_optimize(skip_records(c)); });
+    }
+
+    void bench_header_walk_skip(bench::state& state, const corpus& c) {
+        state.measure([&]{ bench::do_not_optimize(header_walk_skip(c)); });
+    }
+
+    void bench_push_parser(bench::state& state, const corpus& c) {
+        push_parser p{c.encoding};
+        state.measure([&]{
+            p.reset();
+            counting_handler h;
+            for (std::size_t i = 0; i < c.data.size(); i += CHUNK_SIZE) {
+                p.feed(std::span{c.data}.subspan(i, std::min(CHUNK_SIZE, c.data.size() - i)), h);
+            }
+            bench::do_not_optimize(h.elements);
+        });
+    }
+
+    void bench_write_headers(bench::state& state, const corpus& c) {
+        auto headers = collect_headers(c);
+        std::vector<std::byte> out(headers.size() * (max_encoded_tag_size + max_encoded_length_size));
+        auto write_all = [&]{
+            span_sink sink{out.data(), out.data() + out.size()};
+            for (const auto& h : headers) {
+                write_tag(h.t, sink);
+                write_length(h.length, h.indefinite ? length_options::indefinite_required : length_options::definite_required, sink);
+            }
+            return sink.position();
+        };
+        state.bytes_per_run(static_cast<std::size_t>(write_all() - out.data()));
+        state.measure([&]{ bench::do_not_optimize(write_all()); });
+    }
+
+    const bool registered = []{
+        static constexpr std::pair<std::string_view, corpus_bench_fn> benches[] = {
+                {"parse_tag+parse_length", &bench_parse_tag_length},
+                {"try_parse_header", &bench_parse_header},
+                {"tlv_view", &bench_tlv_view},
+                {"tape_build", &bench_tape},
+                {"validate", &bench_validate},
+                {"tree_decode", &bench_tree},
+                {"scan_records", &bench_scan_records},
+                {"skip_element", &bench_skip_element},
+                {"header_walk_skip", &bench_header_walk_skip},
+                {"parallel_tree_decode", &bench_parallel_tree},
+                {"push_parser", &bench_push_parser},
+                {"write_tag+write_length", &bench_write_headers},
+        };
+        static constexpr std::string_view corpus_names[] = {"x509", "snmp", "ldap", "cdr"};
+        for (std::size_t ci = 0; ci < std::size(corpus_names); ++ci) {
+            for (const auto& b : benches) {
+                auto fn = b.second;
+                bench::register_benchmark(std::string{corpus_names[ci]} + "/" + std::string{b.first}, [ci, fn](bench::state& state){
+                    const auto& c = bench::standard_corpora()[ci];
+                    state.items_per_run(c.elements);
+                    state.bytes_per_run(c.data.size());
+                    fn(state, c);
+                });
+            }
+        }
+        return true;
+    }();
+
+}
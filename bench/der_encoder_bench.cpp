@@ -0,0 +1,202 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/der_encoder.h"
+#include "dabers/der_set_of.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+    using namespace dabers;
+
+    using bytes = std::vector<std::byte>;
+
+    const bytes serial(16, std::byte{0x42u});
+    const bytes rsa_oid{std::byte{0x2au}, std::byte{0x86u}, std::byte{0x48u}, std::byte{0x86u}, std::byte{0xf7u},
+                        std::byte{0x0du}, std::byte{0x01u}, std::byte{0x01u}, std::byte{0x0bu}};
+    const bytes cn_oid{std::byte{0x55u}, std::byte{0x04u}, std::byte{0x03u}};
+    const bytes name_value(20, std::byte{0x61u});
+    const bytes key(270, std::byte{0x33u});
+    const bytes signature(257, std::byte{0x44u});
+
+    constexpr int NUM_RDNS = 6;
+
+    bytes tlv(const tag& t, const bytes& contents) {
+        bytes retval;
+        write_tag(t, vector_sink{retval});
+        write_length(der{}, t.constructed, contents.size(), vector_sink{retval});
+        retval.insert(retval.end(), contents.begin(), contents.end());
+        return retval;
+    }
+
+    bytes cat(std::initializer_list<bytes> parts) {
+        bytes retval;
+        for (const auto& p : parts) {
+            retval.insert(retval.end(), p.begin(), p.end());
+        }
+        return retval;
+    }
+
+    /**
+     * A certificate-like structure built the way callers have to today:  encode every
+     * child to its own vector, then copy it into the parent.
+     */
+    bytes nested_vectors() {
+        using namespace universal_tags;
+        auto alg = tlv(sequence::value, cat({tlv(object_identifier::value, rsa_oid), tlv(null::value, {})}));
+        bytes rdns;
+        for (int i = 0; i < NUM_RDNS; ++i) {
+            auto rdn = tlv(set::value, tlv(sequence::value, cat({tlv(object_identifier::value, cn_oid),
+                                                                 tlv(printable_string::value, name_value)})));
+            rdns.insert(rdns.end(), rdn.begin(), rdn.end());
+        }
+        auto name = tlv(sequence::value, rdns);
+        auto tbs = tlv(sequence::value, cat({tlv(integer::value, serial), alg, name, name,
+                                             tlv(sequence::value, cat({alg, tlv(bit_string::value, key)}))}));
+        return tlv(sequence::value, cat({tbs, alg, tlv(bit_string::value, signature)}));
+    }
+
+    void write_alg(der_encoder& enc) {
+        using namespace universal_tags;
+        auto s = enc.constructed(sequence::value);
+        enc.write_primitive(null::value, {});
+        enc.write_primitive(object_identifier::value, rsa_oid);
+    }
+
+    void write_name(der_encoder& enc) {
+        using namespace universal_tags;
+        auto s = enc.constructed(sequence::value);
+        for (int i = 0; i < NUM_RDNS; ++i) {
+            auto rdn = enc.constructed(set::value);
+            auto atv = enc.constructed(sequence::value);
+            enc.write_primitive(printable_string::value, name_value);
+            enc.write_primitive(object_identifier::value, cn_oid);
+        }
+    }
+
+    constexpr std::size_t SET_SIZE = 2000;
+
+    /**
+     * Attribute-like components for a large SET OF:  a shared SEQUENCE/OID prefix with
+     * the differences further in, as in CMS signed attributes or attribute certificates.
+     */
+    std::vector<bytes> make_set_components() {
+        using namespace universal_tags;
+        std::vector<bytes> retval;
+        std::mt19937_64 rng{42};
+        for (std::size_t i = 0; i < SET_SIZE; ++i) {
+            bytes value(8 + rng() % 40);
+            for (auto& b : value) {
+                b = static_cast<std::byte>(0x61u + rng() % 4);
+            }
+            der_encoder enc;
+            {
+                auto seq = enc.constructed(sequence::value);
+                enc.write_primitive(utf8_string::value, value);
+                enc.write_primitive(object_identifier::value, rsa_oid);
+            }
+            retval.push_back(enc.release());
+        }
+        return retval;
+    }
+
+    void backward(der_encoder& enc) {
+        using namespace universal_tags;
+        auto cert = enc.constructed(sequence::value);
+        enc.write_primitive(bit_string::value, signature);
+        write_alg(enc);
+        auto tbs = enc.constructed(sequence::value);
+        {
+            auto spki = enc.constructed(sequence::value);
+            enc.write_primitive(bit_string::value, key);
+            write_alg(enc);
+        }
+        write_name(enc);
+        write_name(enc);
+        write_alg(enc);
+        enc.write_primitive(integer::value, serial);
+    }
+
+}
+
+DABERS_BENCHMARK("der_encode/nested_vectors") {
+    state.items_per_run(1);
+    state.bytes_per_run(nested_vectors().size());
+    state.measure([&]{ bench::do_not_optimize(nested_vectors()); });
+}
+
+DABERS_BENCHMARK("der_encode/der_encoder_reused") {
+    der_encoder enc;
+    backward(enc);
+    if (!std::ranges::equal(enc.data(), nested_vectors())) {
+        throw std::logic_error{"der_encoder output doesn't match the nested encoding."};
+    }
+    state.items_per_run(1);
+    state.bytes_per_run(enc.size());
+    state.measure([&]{
+        enc.clear();
+        backward(enc);
+        bench::do_not_optimize(enc.data().data());
+    });
+}
+
+DABERS_BENCHMARK("der_encode/der_encoder_release") {
+    state.items_per_run(1);
+    state.bytes_per_run(nested_vectors().size());
+    state.measure([&]{
+        der_encoder enc{2048};
+        backward(enc);
+        bench::do_not_optimize(enc.release());
+    });
+}
+
+DABERS_BENCHMARK("der_set_of/radix_sort") {
+    const auto components = make_set_components();
+    der_set_of set;
+    der_encoder enc;
+    state.items_per_run(SET_SIZE);
+    state.measure([&]{
+        set.clear();
+        for (const auto& c : components) {
+            set.add(c);
+        }
+        enc.clear();
+        set.write(enc);
+        bench::do_not_optimize(enc.data().data());
+    });
+}
+
+DABERS_BENCHMARK("der_set_of/std_sort_memcmp") {
+    //Sorting the component vectors themselves with a padded memcmp comparator.
+    const auto components = make_set_components();
+    std::vector<bytes> sorted;
+    der_encoder enc;
+    state.items_per_run(SET_SIZE);
+    state.measure([&]{
+        sorted = components;
+        std::sort(sorted.begin(), sorted.end(), [](const bytes& a, const bytes& b){
+            const auto n = std::min(a.size(), b.size());
+            if (auto c = std::memcmp(a.data(), b.data(), n); c != 0) {
+                return c < 0;
+            }
+            const auto& longer = a.size() > b.size() ? a : b;
+            const bool rest_zero = std::all_of(longer.begin() + static_cast<std::ptrdiff_t>(n), longer.end(),
+                                               [](std::byte x){ return x == std::byte{0}; });
+            return !rest_zero && b.size() > a.size();
+        });
+        enc.clear();
+        auto s = enc.constructed(universal_tags::set::value);
+        for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
+            enc.write_encoded(*it);
+        }
+        s.close();
+        bench::do_not_optimize(enc.data().data());
+    });
+}
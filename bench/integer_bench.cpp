@@ -0,0 +1,97 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/integer.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+    using namespace dabers;
+
+    constexpr std::size_t COUNT = 10'000;
+
+    /**
+     * Contents octets of INTEGERs, mostly small like versions and counters, some the size
+     * of timestamps and serial numbers.
+     */
+    struct integer_stream {
+        std::vector<std::byte> data;
+        std::vector<std::size_t> sizes;
+    };
+
+    integer_stream make_integers() {
+        integer_stream retval;
+        std::mt19937_64 rng{42};
+        std::array<std::byte, max_encoded_integer_size> buf{};
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            const auto bits = rng() % 4 == 0 ? 1 + rng() % 63 : 1 + rng() % 16;
+            const auto v = static_cast<int64_t>(rng() >> (64 - bits)) * (rng() % 8 == 0 ? -1 : 1);
+            const auto n = encode_integer(v, buf.data());
+            retval.data.insert(retval.data.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(n));
+            retval.sizes.push_back(n);
+        }
+        return retval;
+    }
+
+    /**
+     * Octet at a time, for comparison.
+     */
+    int64_t loop_decode(std::span<const std::byte> contents) {
+        int64_t v = (contents[0] & std::byte{0x80u}) != std::byte{0} ? -1 : 0;
+        for (auto b : contents) {
+            v = static_cast<int64_t>(static_cast<uint64_t>(v) << 8) | std::to_integer<int64_t>(b);
+        }
+        return v;
+    }
+
+    template <typename Decode>
+    void bench_decode(bench::state& state, Decode decode) {
+        const auto s = make_integers();
+        state.items_per_run(COUNT);
+        state.bytes_per_run(s.data.size());
+        state.measure([&]{
+            const std::byte* cur = s.data.data();
+            int64_t sum = 0;
+            for (auto n : s.sizes) {
+                sum += decode(std::span{cur, n});
+                cur += n;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+
+}
+
+DABERS_BENCHMARK("integer/try_decode_integer") {
+    bench_decode(state, [](std::span<const std::byte> c){
+        int64_t v = 0;
+        try_decode_integer(c, v);
+        return v;
+    });
+}
+
+DABERS_BENCHMARK("integer/loop_reference") {
+    bench_decode(state, &loop_decode);
+}
+
+DABERS_BENCHMARK("integer/encode_integer") {
+    std::vector<int64_t> values;
+    std::mt19937_64 rng{42};
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        values.push_back(static_cast<int64_t>(rng() >> (rng() % 64)));
+    }
+    std::vector<std::byte> out(COUNT * max_encoded_integer_size);
+    state.items_per_run(COUNT);
+    state.measure([&]{
+        std::byte* cur = out.data();
+        for (auto v : values) {
+            cur += encode_integer(v, cur);
+        }
+        bench::do_not_optimize(cur);
+    });
+}
@@ -0,0 +1,147 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/tag.h"
+#include "dabers/length.h"
+
+#include <random>
+#include <span>
+#include <stdexcept>
+
+namespace {
+
+    using namespace dabers;
+
+    struct frame_corpus {
+        std::vector<std::byte> data;
+        std::vector<std::span<const std::byte>> frames;
+    };
+
+    /**
+     * Builds the kind of traffic seen during a flood of garbage: truncated extended tags,
+     * tag numbers with leading zero octets, truncated and oversized long form lengths, and
+     * indefinite lengths on primitive elements.
+     */
+    frame_corpus make_malformed_corpus(std::size_t count) {
+        static constexpr unsigned int patterns[][4] = {
+                {0x1fu, 0x00u, 0x00u, 0x00u},   //Truncated extended tag number
+                {0x1fu, 0x81u, 0x00u, 0x00u},   //Truncated extended tag number
+                {0x3fu, 0x80u, 0x01u, 0x00u},   //Leading zero in tag number
+                {0x5fu, 0x05u, 0x00u, 0x00u},   //Extended tag number less than 31
+                {0x30u, 0x84u, 0x01u, 0x02u},   //Truncated long form length
+                {0x04u, 0x80u, 0x00u, 0x00u},   //Indefinite length on a primitive
+                {0x02u, 0xffu, 0x00u, 0x00u},   //Long form length too long
+        };
+        static constexpr std::size_t pattern_sizes[] = {1, 2, 4, 2, 4, 2, 2};
+        constexpr std::size_t num_patterns = std::size(pattern_sizes);
+
+        frame_corpus retval;
+        std::vector<std::pair<std::size_t, std::size_t>> offsets;
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<std::size_t> dist{0, num_patterns - 1};
+        for (std::size_t i = 0; i < count; ++i) {
+            auto p = dist(rng);
+            offsets.emplace_back(retval.data.size(), pattern_sizes[p]);
+            for (std::size_t j = 0; j < pattern_sizes[p]; ++j) {
+                retval.data.push_back(static_cast<std::byte>(patterns[p][j]));
+            }
+        }
+        for (auto [off, size] : offsets) {
+            retval.frames.emplace_back(retval.data.data() + off, size);
+        }
+        return retval;
+    }
+
+    frame_corpus make_valid_corpus(std::size_t count) {
+        static constexpr unsigned int patterns[][4] = {
+                {0x30u, 0x82u, 0x01u, 0x02u},
+                {0x02u, 0x01u, 0x00u, 0x00u},
+                {0x9fu, 0x81u, 0x00u, 0x05u},
+                {0x04u, 0x81u, 0x90u, 0x00u},
+        };
+        static constexpr std::size_t pattern_sizes[] = {4, 2, 4, 3};
+        constexpr std::size_t num_patterns = std::size(pattern_sizes);
+
+        frame_corpus retval;
+        std::vector<std::pair<std::size_t, std::size_t>> offsets;
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<std::size_t> dist{0, num_patterns - 1};
+        for (std::size_t i = 0; i < count; ++i) {
+            auto p = dist(rng);
+            offsets.emplace_back(retval.data.size(), pattern_sizes[p]);
+            for (std::size_t j = 0; j < pattern_sizes[p]; ++j) {
+                retval.data.push_back(static_cast<std::byte>(patterns[p][j]));
+            }
+        }
+        for (auto [off, size] : offsets) {
+            retval.frames.emplace_back(retval.data.data() + off, size);
+        }
+        return retval;
+    }
+
+    std::size_t decode_throwing(const frame_corpus& c) {
+        std::size_t failures = 0;
+        for (auto f : c.frames) {
+            const std::byte* beg = f.data();
+            const std::byte* const end = f.data() + f.size();
+            try {
+                auto t = parse_tag(beg, end);
+                bench::do_not_optimize(parse_length(ber{}, t.constructed, beg, end));
+            }
+            catch (const std::runtime_error&) {
+                ++failures;
+            }
+        }
+        return failures;
+    }
+
+    std::size_t decode_error_code(const frame_corpus& c) {
+        std::size_t failures = 0;
+        for (auto f : c.frames) {
+            const std::byte* beg = f.data();
+            const std::byte* const end = f.data() + f.size();
+            tag t;
+            std::optional<uint64_t> len;
+            if (try_parse_tag(beg, end, t) != decode_error::none ||
+                try_parse_length(ber{}, t.constructed, beg, end, len) != decode_error::none) {
+                ++failures;
+            }
+            bench::do_not_optimize(len);
+        }
+        return failures;
+    }
+
+    constexpr std::size_t CORPUS_SIZE = 10'000;
+
+}
+
+DABERS_BENCHMARK("malformed_flood/throwing") {
+    auto corpus = make_malformed_corpus(CORPUS_SIZE);
+    state.items_per_run(corpus.frames.size());
+    state.bytes_per_run(corpus.data.size());
+    state.measure([&]{ bench::do_not_optimize(decode_throwing(corpus)); });
+}
+
+DABERS_BENCHMARK("malformed_flood/error_code") {
+    auto corpus = make_malformed_corpus(CORPUS_SIZE);
+    state.items_per_run(corpus.frames.size());
+    state.bytes_per_run(corpus.data.size());
+    state.measure([&]{ bench::do_not_optimize(decode_error_code(corpus)); });
+}
+
+DABERS_BENCHMARK("valid_headers/throwing") {
+    auto corpus = make_valid_corpus(CORPUS_SIZE);
+    state.items_per_run(corpus.frames.size());
+    state.bytes_per_run(corpus.data.size());
+    state.measure([&]{ bench::do_not_optimize(decode_throwing(corpus)); });
+}
+
+DABERS_BENCHMARK("valid_headers/error_code") {
+    auto corpus = make_valid_corpus(CORPUS_SIZE);
+    state.items_per_run(corpus.frames.size());
+    state.bytes_per_run(corpus.data.size());
+    state.measure([&]{ bench::do_not_optimize(decode_error_code(corpus)); });
+}
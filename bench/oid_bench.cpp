@@ -0,0 +1,117 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/oid.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using namespace dabers;
+
+    constexpr std::size_t COUNT = 10'000;
+
+    /**
+     * Contents octets of OIDs, drawn from the standard registry the way they show up in
+     * certificates and SNMP traps, with a few unknown private enterprise ones mixed in.
+     */
+    struct oid_stream {
+        std::vector<std::byte> data;
+        std::vector<std::size_t> sizes;
+    };
+
+    oid_stream make_oids() {
+        oid_stream retval;
+        std::mt19937_64 rng{42};
+        std::vector<std::byte> buf;
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            if (rng() % 8 == 0) {
+                const std::vector<uint64_t> arcs{1, 3, 6, 1, 4, 1, rng() % 60000, rng() % 100, rng() % 10};
+                buf.resize(encoded_oid_size(arcs));
+                encode_oid(arcs, buf.data());
+            }
+            else {
+                const auto b = standard_oids[rng() % standard_oids.size()].oid.bytes();
+                buf.assign(b.begin(), b.end());
+            }
+            retval.data.insert(retval.data.end(), buf.begin(), buf.end());
+            retval.sizes.push_back(buf.size());
+        }
+        return retval;
+    }
+
+    /**
+     * Octet at a time, for comparison.
+     */
+    std::size_t loop_decode(std::span<const std::byte> contents, std::span<uint64_t> arcs) {
+        std::size_t n = 0;
+        uint64_t v = 0;
+        for (auto b : contents) {
+            v = (v << 7) | std::to_integer<uint64_t>(b & std::byte{0x7fu});
+            if ((b & std::byte{0x80u}) == std::byte{0}) {
+                if (n == 0) {
+                    const uint64_t first = v < 80 ? v / 40 : 2;
+                    arcs[n++] = first;
+                    arcs[n++] = v - first * 40;
+                }
+                else {
+                    arcs[n++] = v;
+                }
+                v = 0;
+            }
+        }
+        return n;
+    }
+
+    template <typename F>
+    void bench_stream(bench::state& state, F f) {
+        const auto s = make_oids();
+        state.items_per_run(COUNT);
+        state.bytes_per_run(s.data.size());
+        state.measure([&]{
+            const std::byte* cur = s.data.data();
+            uint64_t sum = 0;
+            for (auto n : s.sizes) {
+                sum += f(std::span{cur, n});
+                cur += n;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+
+}
+
+DABERS_BENCHMARK("oid/try_decode_oid") {
+    std::array<uint64_t, 32> arcs{};
+    bench_stream(state, [&](std::span<const std::byte> c){
+        std::size_t count = 0;
+        try_decode_oid(c, arcs, count);
+        return arcs[count - 1];
+    });
+}
+
+DABERS_BENCHMARK("oid/loop_reference") {
+    std::array<uint64_t, 32> arcs{};
+    bench_stream(state, [&](std::span<const std::byte> c){
+        return arcs[loop_decode(c, arcs) - 1];
+    });
+}
+
+DABERS_BENCHMARK("oid/registry_find") {
+    bench_stream(state, [](std::span<const std::byte> c){
+        return standard_oids.find(c);
+    });
+}
+
+DABERS_BENCHMARK("oid/dotted_string_compare") {
+    //What the registry replaces:  formatting the OID and comparing the dotted strings.
+    const std::string wanted{standard_oids[standard_oids.index_of("sha256WithRSAEncryption")].dotted};
+    bench_stream(state, [&](std::span<const std::byte> c){
+        return static_cast<std::size_t>(oid_to_string(c) == wanted);
+    });
+}
@@ -0,0 +1,89 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/header.h"
+#include "dabers/length.h"
+#include "dabers/tag.h"
+
+#include <random>
+
+namespace {
+
+    using namespace dabers;
+
+    /**
+     * A flat run of small primitive elements, which is what a decoder spends most of its
+     * time looping over.
+     */
+    std::vector<std::byte> make_elements(std::size_t count) {
+        std::vector<std::byte> retval;
+        std::mt19937_64 rng{42};
+        for (std::size_t i = 0; i < count; ++i) {
+            const tag t{tag_class_type::universal, false, 1 + rng() % 30};
+            const auto len = rng() % 8 == 0 ? 128 + rng() % 200 : rng() % 32;
+            write_tag(t, vector_sink{retval});
+            write_length(der{}, false, len, vector_sink{retval});
+            retval.resize(retval.size() + len, std::byte{0x41u});
+        }
+        return retval;
+    }
+
+    constexpr std::size_t CORPUS_SIZE = 10'000;
+
+}
+
+DABERS_BENCHMARK("element_walk/parse_tag+parse_length") {
+    auto buf = make_elements(CORPUS_SIZE);
+    state.items_per_run(CORPUS_SIZE);
+    state.bytes_per_run(buf.size());
+    state.measure([&]{
+        const std::byte* beg = buf.data();
+        const std::byte* const end = buf.data() + buf.size();
+        while (beg != end) {
+            auto t = parse_tag(beg, end);
+            beg += *parse_length(der{}, t.constructed, beg, end);
+        }
+        bench::do_not_optimize(beg);
+    });
+}
+
+DABERS_BENCHMARK("element_walk/try_parse_header") {
+    auto buf = make_elements(CORPUS_SIZE);
+    state.items_per_run(CORPUS_SIZE);
+    state.bytes_per_run(buf.size());
+    state.measure([&]{
+        const std::byte* beg = buf.data();
+        const std::byte* const end = buf.data() + buf.size();
+        tlv_header h;
+        while (beg != end && try_parse_header(der{}, beg, end, h) == decode_error::none) {
+            beg += h.contents.size();
+        }
+        bench::do_not_optimize(beg);
+    });
+}
+
+DABERS_BENCHMARK("length_walk/try_parse_length") {
+    //Mostly one and two byte long forms, as seen in certificates and directory entries.
+    std::vector<std::byte> buf;
+    std::mt19937_64 rng{42};
+    for (std::size_t i = 0; i < CORPUS_SIZE; ++i) {
+        const auto pick = rng() % 20;
+        const uint64_t len = pick < 8 ? rng() % 128 : pick < 14 ? 128 + rng() % 128 : pick < 19 ? 256 + rng() % 65280 : rng() % (uint64_t{1} << 40);
+        write_length(len, length_options::definite_required, vector_sink{buf});
+    }
+    state.items_per_run(CORPUS_SIZE);
+    state.bytes_per_run(buf.size());
+    state.measure([&]{
+        const std::byte* beg = buf.data();
+        const std::byte* const end = buf.data() + buf.size();
+        uint64_t sum = 0;
+        std::optional<uint64_t> len;
+        while (beg != end && try_parse_length(length_options::definite_required, beg, end, len) == decode_error::none) {
+            sum += *len;
+        }
+        bench::do_not_optimize(sum);
+    });
+}
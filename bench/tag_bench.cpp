@@ -0,0 +1,134 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+#include "corpus.h"
+
+#include "dabers/header.h"
+#include "dabers/tag.h"
+
+#include <random>
+#include <string>
+#include <utility>
+
+namespace {
+
+    using namespace dabers;
+    using bench::corpus;
+
+    /**
+     * Just the identifier octets of every element in a corpus, back to back, so the tag
+     * decoder is all that's measured while keeping the corpus' real mix of tags.
+     */
+    struct tag_stream {
+        std::vector<std::byte> data;
+        std::size_t tags = 0;
+    };
+
+    tag_stream collect_tags(const corpus& c) {
+        tag_stream retval;
+        const std::byte* cur = c.data.data();
+        const std::byte* const end = c.data.data() + c.data.size();
+        tlv_header h;
+        std::array<std::byte, max_encoded_tag_size> buf{};
+        while (cur != end && try_parse_header(c.encoding, cur, end, h) == decode_error::none) {
+            if (!h.id.constructed) {
+                cur += h.contents.size();
+            }
+            const auto n = encode_tag(h.id, buf.data());
+            retval.data.insert(retval.data.end(), buf.begin(), buf.begin() + n);
+            ++retval.tags;
+        }
+        return retval;
+    }
+
+    /**
+     * Application class tags numbered 128 and up on every element, like the proprietary
+     * schemas which number their types in the thousands.
+     */
+    tag_stream make_high_tags(std::size_t count) {
+        tag_stream retval;
+        std::mt19937_64 rng{42};
+        std::array<std::byte, max_encoded_tag_size> buf{};
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto pick = rng() % 10;
+            const uint64_t number = pick < 6 ? 128 + rng() % 16256 : pick < 9 ? 16384 + rng() % 2080768 : rng() % (uint64_t{1} << 40);
+            const auto n = encode_tag(tag{tag_class_type::application, rng() % 2 == 0, number}, buf.data());
+            retval.data.insert(retval.data.end(), buf.begin(), buf.begin() + n);
+            ++retval.tags;
+        }
+        return retval;
+    }
+
+    /**
+     * The tag decoder as it was before the identifier octet table, masking out each field
+     * of the first octet.
+     */
+    bool mask_decode_tag(const std::byte*& cur, const std::byte* const end, tag& out) {
+        const std::byte* p = cur;
+        const auto first = *p++;
+        out.tag_class = static_cast<tag_class_type>(first & std::byte{0xc0u});
+        out.constructed = (first & std::byte{0x20u}) != std::byte{0};
+        out.tag_number = static_cast<uint64_t>(first & std::byte{0x1fu});
+        if (out.tag_number == 0x1fu) {
+            uint64_t num = 0;
+            bool more = true;
+            while (more) {
+                if (p == end) {
+                    return false;
+                }
+                const auto next = *p++;
+                more = (next & std::byte{0x80u}) != std::byte{0};
+                num = (num << 7) | static_cast<uint8_t>(next & std::byte{0x7fu});
+            }
+            out.tag_number = num;
+        }
+        cur = p;
+        return true;
+    }
+
+    template <typename Decode>
+    void bench_tags(bench::state& state, const tag_stream& s, Decode decode) {
+        state.items_per_run(s.tags);
+        state.bytes_per_run(s.data.size());
+        state.measure([&]{
+            const std::byte* cur = s.data.data();
+            const std::byte* const end = s.data.data() + s.data.size();
+            uint64_t sum = 0;
+            tag t;
+            while (cur != end && decode(cur, end, t)) {
+                sum += t.tag_number;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+
+    const bool registered = []{
+        static constexpr std::string_view corpus_names[] = {"x509", "snmp", "ldap", "cdr"};
+        for (std::size_t ci = 0; ci < std::size(corpus_names); ++ci) {
+            const auto prefix = "tags/" + std::string{corpus_names[ci]};
+            bench::register_benchmark(prefix + "/try_parse_tag", [ci](bench::state& state){
+                const auto s = collect_tags(bench::standard_corpora()[ci]);
+                bench_tags(state, s, [](const std::byte*& cur, const std::byte* end, tag& t){
+                    return try_parse_tag(cur, end, t) == decode_error::none;
+                });
+            });
+            bench::register_benchmark(prefix + "/mask_reference", [ci](bench::state& state){
+                const auto s = collect_tags(bench::standard_corpora()[ci]);
+                bench_tags(state, s, &mask_decode_tag);
+            });
+        }
+        bench::register_benchmark("tags/high_numbers/try_parse_tag", [](bench::state& state){
+            const auto s = make_high_tags(10'000);
+            bench_tags(state, s, [](const std::byte*& cur, const std::byte* end, tag& t){
+                return try_parse_tag(cur, end, t) == decode_error::none;
+            });
+        });
+        bench::register_benchmark("tags/high_numbers/mask_reference", [](bench::state& state){
+            bench_tags(state, make_high_tags(10'000), &mask_decode_tag);
+        });
+        return true;
+    }();
+
+}
@@ -0,0 +1,118 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/time.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+    using namespace dabers;
+    using namespace std::chrono;
+
+    constexpr std::size_t COUNT = 10'000;
+
+    /**
+     * Contents octets of times the way certificates and call records have them:  validity
+     * periods from the last few decades, to the second.
+     */
+    struct time_stream {
+        std::vector<std::byte> data;
+        std::vector<std::size_t> sizes;
+    };
+
+    template <typename Encode>
+    time_stream make_times(Encode encode) {
+        time_stream retval;
+        std::mt19937_64 rng{42};
+        std::array<std::byte, max_encoded_time_size> buf{};
+        const auto base = asn1_time{sys_days{year{1995} / 1 / 1}};
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            const auto n = encode(base + seconds{static_cast<int64_t>(rng() % 1'500'000'000u)}, buf.data());
+            retval.data.insert(retval.data.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(n));
+            retval.sizes.push_back(n);
+        }
+        return retval;
+    }
+
+    /**
+     * A digit at a time, for comparison.
+     */
+    bool loop_generalized_time(std::span<const std::byte> s, asn1_time& out) {
+        if (s.size() != 15 || s[14] != std::byte{'Z'}) {
+            return false;
+        }
+        int v[7] = {};
+        for (std::size_t i = 0; i < 14; ++i) {
+            const auto c = std::to_integer<int>(s[i]);
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            v[i / 2] = v[i / 2] * 10 + (c - '0');
+        }
+        const year_month_day ymd{year{v[0] * 100 + v[1]}, month{static_cast<unsigned int>(v[2])}, day{static_cast<unsigned int>(v[3])}};
+        if (!ymd.ok() || v[4] > 23 || v[5] > 59 || v[6] > 59) {
+            return false;
+        }
+        out = asn1_time{sys_days{ymd}} + hours{v[4]} + minutes{v[5]} + seconds{v[6]};
+        return true;
+    }
+
+    template <typename F>
+    void bench_stream(bench::state& state, const time_stream& s, F f) {
+        state.items_per_run(COUNT);
+        state.bytes_per_run(s.data.size());
+        state.measure([&]{
+            const std::byte* cur = s.data.data();
+            int64_t sum = 0;
+            for (auto n : s.sizes) {
+                asn1_time t{};
+                f(std::span{cur, n}, t);
+                sum += t.time_since_epoch().count();
+                cur += n;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+
+}
+
+DABERS_BENCHMARK("time/utc/try_decode_utc_time") {
+    bench_stream(state, make_times(&encode_utc_time), [](std::span<const std::byte> s, asn1_time& t){
+        return try_decode_utc_time(s, t, rules::der);
+    });
+}
+
+DABERS_BENCHMARK("time/generalized/try_decode_generalized_time") {
+    bench_stream(state, make_times(&encode_generalized_time), [](std::span<const std::byte> s, asn1_time& t){
+        return try_decode_generalized_time(s, t, rules::der);
+    });
+}
+
+DABERS_BENCHMARK("time/generalized/loop_reference") {
+    bench_stream(state, make_times(&encode_generalized_time), &loop_generalized_time);
+}
+
+DABERS_BENCHMARK("time/generalized/encode_generalized_time") {
+    const auto times = make_times(&encode_generalized_time);
+    std::vector<asn1_time> points;
+    const std::byte* cur = times.data.data();
+    for (auto n : times.sizes) {
+        points.push_back(decode_generalized_time({cur, n}));
+        cur += n;
+    }
+    std::vector<std::byte> out(max_encoded_time_size);
+    state.items_per_run(COUNT);
+    state.bytes_per_run(times.data.size());
+    state.measure([&]{
+        std::size_t total = 0;
+        for (auto t : points) {
+            total += encode_generalized_time(t, out.data());
+        }
+        bench::do_not_optimize(total);
+    });
+}
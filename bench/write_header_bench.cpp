@@ -0,0 +1,88 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "bench.h"
+
+#include "dabers/tag.h"
+#include "dabers/length.h"
+
+#include <random>
+
+namespace {
+
+    using namespace dabers;
+
+    struct header {
+        tag t;
+        uint64_t length = 0;
+    };
+
+    /**
+     * Mostly low tag numbers and short lengths, like real traffic, with some high tag
+     * numbers and long form lengths mixed in.
+     */
+    std::vector<header> make_headers(std::size_t count) {
+        std::vector<header> retval;
+        retval.reserve(count);
+        std::mt19937_64 rng{42};
+        std::uniform_int_distribution<int> pct{0, 99};
+        std::uniform_int_distribution<int> cls{0, 3};
+        for (std::size_t i = 0; i < count; ++i) {
+            header h;
+            h.t.tag_class = static_cast<tag_class_type>(cls(rng) << 6);
+            h.t.constructed = pct(rng) < 30;
+            h.t.tag_number = pct(rng) < 95 ? rng() % 31 : 31 + rng() % 100'000;
+            h.length = pct(rng) < 80 ? rng() % 128 : rng() % 10'000'000;
+            retval.push_back(h);
+        }
+        return retval;
+    }
+
+    constexpr std::size_t CORPUS_SIZE = 10'000;
+
+}
+
+DABERS_BENCHMARK("write_header/std_function") {
+    auto headers = make_headers(CORPUS_SIZE);
+    std::vector<std::byte> out(headers.size() * (max_encoded_tag_size + max_encoded_length_size));
+    state.items_per_run(headers.size());
+    state.measure([&]{
+        std::byte* cur = out.data();
+        const std::function<void(std::byte)> output = [&cur](std::byte b){ *cur++ = b; };
+        for (const auto& h : headers) {
+            write_tag(h.t, output);
+            write_length(h.length, length_options::definite_required, output);
+        }
+        bench::do_not_optimize(cur);
+    });
+}
+
+DABERS_BENCHMARK("write_header/back_inserter") {
+    auto headers = make_headers(CORPUS_SIZE);
+    std::vector<std::byte> out;
+    out.reserve(headers.size() * (max_encoded_tag_size + max_encoded_length_size));
+    state.items_per_run(headers.size());
+    state.measure([&]{
+        out.clear();
+        for (const auto& h : headers) {
+            write_tag(h.t, std::back_inserter(out));
+            write_length(der{}, h.t.constructed, h.length, std::back_inserter(out));
+        }
+        bench::do_not_optimize(out.data());
+    });
+}
+
+DABERS_BENCHMARK("write_header/span_sink") {
+    auto headers = make_headers(CORPUS_SIZE);
+    std::vector<std::byte> out(headers.size() * (max_encoded_tag_size + max_encoded_length_size));
+    state.items_per_run(headers.size());
+    state.measure([&]{
+        span_sink sink{out.data(), out.data() + out.size()};
+        for (const auto& h : headers) {
+            write_tag(h.t, sink);
+            write_length(der{}, h.t.constructed, h.length, sink);
+        }
+        bench::do_not_optimize(sink.position());
+    });
+}
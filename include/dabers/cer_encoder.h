@@ -0,0 +1,316 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_CER_ENCODER_H
+#define DABERS_CER_ENCODER_H
+
+#include "dabers/length.h"
+#include "dabers/sink.h"
+#include "dabers/tag.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <span>
+#include <utility>
+
+namespace dabers {
+
+    /**
+     * Encodes CER front to back straight into a sink.  Constructed elements use the
+     * indefinite length form, so nothing needs to be known about their contents up front,
+     * and OCTET STRING and BIT STRING values are split into 1000 octet segments as the
+     * data arrives (X.690 9.2), so arbitrarily large values are written with constant memory.
+     *
+     *     cer_encoder enc{vector_sink{out}};
+     *     {
+     *         auto seq = enc.constructed(universal_tags::sequence::value);
+     *         enc.write_primitive(universal_tags::integer::value, version);
+     *         auto content = enc.octet_string();
+     *         while (read_chunk(chunk)) {
+     *             content.write(chunk);
+     *         }
+     *     }
+     *
+     * Only one string can be open at a time, and nothing else may be written until it's finished.
+     */
+    template <byte_sink S>
+    class cer_encoder {
+    public:
+        /**
+         * The most contents octets in a primitive string, and in each segment of a constructed one.
+         */
+        static constexpr std::size_t segment_size = 1000;
+
+        /**
+         * Writes the end-of-contents octets of a constructed element when it is destroyed,
+         * or when close() is called.  close() is where a sink's exception comes out;  the
+         * destructor swallows it, the way a stream's does, and writes nothing at all while an
+         * exception is unwinding the stack, since the element's contents are incomplete.
+         */
+        class scope {
+        public:
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+            scope(scope&& other) noexcept :
+                    m_encoder{std::exchange(other.m_encoder, nullptr)}, m_exceptions{other.m_exceptions} {}
+            scope& operator=(scope&&) = delete;
+            ~scope() {
+                if (m_encoder && std::uncaught_exceptions() > m_exceptions) {
+                    --m_encoder->m_depth;
+                    m_encoder = nullptr;
+                }
+                try {
+                    close();
+                }
+                catch (...) {}
+            }
+
+            void close() {
+                //Closed first, so a sink which throws doesn't get the octets again from the destructor.
+                if (auto* enc = std::exchange(m_encoder, nullptr)) {
+                    enc->end_constructed();
+                }
+            }
+
+        private:
+            friend class cer_encoder;
+            explicit scope(cer_encoder& enc) noexcept : m_encoder{&enc}, m_exceptions{std::uncaught_exceptions()} {}
+
+            cer_encoder* m_encoder;
+            int m_exceptions;
+        };
+
+        /**
+         * Writes an OCTET STRING or BIT STRING value as it arrives.  Up to one segment is
+         * held back:  once more than a segment's worth has been written the value switches
+         * to the constructed form and full segments are written out as more data arrives.
+         * As with scope, finish() is where a sink's exception comes out, and the destructor
+         * writes nothing while an exception is unwinding the stack.
+         */
+        class string_writer {
+        public:
+            string_writer(const string_writer&) = delete;
+            string_writer& operator=(const string_writer&) = delete;
+            string_writer(string_writer&& other) noexcept :
+                    m_encoder{std::exchange(other.m_encoder, nullptr)}, m_tag{other.m_tag}, m_bits{other.m_bits},
+                    m_constructed{other.m_constructed}, m_exceptions{other.m_exceptions} {}
+            string_writer& operator=(string_writer&&) = delete;
+            ~string_writer() {
+                if (m_encoder && std::uncaught_exceptions() > m_exceptions) {
+                    m_encoder->m_fill = 0;
+                    m_encoder = nullptr;
+                }
+                try {
+                    finish();
+                }
+                catch (...) {}
+            }
+
+            /**
+             * Adds to the value.  For a BIT STRING these are the bit octets, without the
+             * unused bits octet.
+             */
+            void write(std::span<const std::byte> data) {
+                assert(m_encoder != nullptr);
+                auto& enc = *m_encoder;
+                const auto payload = payload_size();
+                while (!data.empty()) {
+                    if (enc.m_fill == payload) {
+                        //There's more than fits in one segment, so this has to be constructed.
+                        start_constructed();
+                        write_segment(enc, enc.m_segment.data(), payload, 0);
+                        enc.m_fill = 0;
+                    }
+                    if (m_constructed && enc.m_fill == 0) {
+                        //Full segments can go straight from the caller's data, as long as
+                        //  there's something after them.
+                        while (data.size() > payload) {
+                            write_segment(enc, data.data(), payload, 0);
+                            data = data.subspan(payload);
+                        }
+                    }
+                    const auto n = std::min(payload - enc.m_fill, data.size());
+                    std::memcpy(enc.m_segment.data() + enc.m_fill, data.data(), n);
+                    enc.m_fill += n;
+                    data = data.subspan(n);
+                }
+            }
+
+            /**
+             * Writes whatever is held back, and the end-of-contents octets for the constructed form.
+             * @param unused_bits For a BIT STRING, the number of unused bits in the final octet.
+             */
+            void finish(const uint8_t unused_bits = 0) {
+                if (!m_encoder) {
+                    return;
+                }
+                //Finished first, as with scope::close.
+                auto& enc = *std::exchange(m_encoder, nullptr);
+                const auto fill = std::exchange(enc.m_fill, 0);
+                if (m_constructed) {
+                    write_segment(enc, enc.m_segment.data(), fill, unused_bits);
+                    enc.write_end_of_contents();
+                }
+                else {
+                    auto t = m_tag;
+                    t.constructed = false;
+                    enc.write_header(t, fill + (m_bits ? 1 : 0));
+                    if (m_bits) {
+                        enc.m_sink.put(std::byte{unused_bits});
+                    }
+                    sink_write(enc.m_sink, enc.m_segment.data(), fill);
+                }
+            }
+
+        private:
+            friend class cer_encoder;
+            string_writer(cer_encoder& enc, const tag& t, const bool bits) noexcept :
+                    m_encoder{&enc}, m_tag{t}, m_bits{bits}, m_exceptions{std::uncaught_exceptions()} {
+                enc.m_fill = 0;
+            }
+
+            /**
+             * A BIT STRING segment's contents include its unused bits octet.
+             */
+            [[nodiscard]] std::size_t payload_size() const noexcept { return m_bits ? segment_size - 1 : segment_size; }
+
+            void start_constructed() {
+                if (!m_constructed) {
+                    auto t = m_tag;
+                    t.constructed = true;
+                    m_encoder->write_indefinite_header(t);
+                    m_constructed = true;
+                }
+            }
+
+            void write_segment(cer_encoder& enc, const std::byte* data, const std::size_t size, const uint8_t unused_bits) const {
+                if (m_bits) {
+                    enc.write_header(universal_tags::bit_string::value, size + 1);
+                    enc.m_sink.put(std::byte{unused_bits});
+                }
+                else {
+                    enc.write_header(universal_tags::octet_string::value, size);
+                }
+                sink_write(enc.m_sink, data, size);
+            }
+
+            cer_encoder* m_encoder;
+            tag m_tag;
+            bool m_bits;
+            bool m_constructed = false;
+            int m_exceptions;
+        };
+
+        explicit cer_encoder(S sink) : m_sink{std::move(sink)} {}
+
+        /**
+         * Opens a constructed element with the indefinite length form.  Everything written
+         * until the scope is closed becomes its contents.
+         * @param t The tag, which will be marked as constructed.
+         */
+        [[nodiscard]] scope constructed(tag t) {
+            t.constructed = true;
+            write_indefinite_header(t);
+            ++m_depth;
+            return scope{*this};
+        }
+
+        /**
+         * Starts an OCTET STRING value, or another type encoded like one (e.g. an implicitly
+         * tagged OCTET STRING).  The segments are always universal OCTET STRINGs.
+         */
+        [[nodiscard]] string_writer octet_string(const tag& t = universal_tags::octet_string::value) {
+            return string_writer{*this, t, false};
+        }
+
+        /**
+         * Starts a BIT STRING value.  The segments are always universal BIT STRINGs.
+         */
+        [[nodiscard]] string_writer bit_string(const tag& t = universal_tags::bit_string::value) {
+            return string_writer{*this, t, true};
+        }
+
+        void write_octet_string(std::span<const std::byte> value, const tag& t = universal_tags::octet_string::value) {
+            auto s = octet_string(t);
+            s.write(value);
+            s.finish();
+        }
+
+        /**
+         * @param bits The bit octets, without the unused bits octet.
+         * @param unused_bits The number of unused bits in the final octet.
+         */
+        void write_bit_string(std::span<const std::byte> bits, const uint8_t unused_bits, const tag& t = universal_tags::bit_string::value) {
+            auto s = bit_string(t);
+            s.write(bits);
+            s.finish(unused_bits);
+        }
+
+        /**
+         * Writes a primitive element.  Strings over segment_size octets have to use
+         * write_octet_string/write_bit_string instead to be valid CER.
+         * @param t The tag, which will be marked as primitive.
+         */
+        void write_primitive(tag t, std::span<const std::byte> contents) {
+            t.constructed = false;
+            write_header(t, contents.size());
+            sink_write(m_sink, contents.data(), contents.size());
+        }
+
+        /**
+         * Writes an already encoded element (or several of them).
+         */
+        void write_encoded(std::span<const std::byte> encoded) {
+            sink_write(m_sink, encoded.data(), encoded.size());
+        }
+
+        /**
+         * The number of open constructed elements.
+         */
+        [[nodiscard]] std::size_t depth() const noexcept { return m_depth; }
+
+        [[nodiscard]] S& sink() noexcept { return m_sink; }
+
+    private:
+        void write_header(const tag& t, const uint64_t length) {
+            std::array<std::byte, max_encoded_tag_size + max_encoded_length_size> buf{};
+            auto size = encode_tag(t, buf.data());
+            size += encode_length(length, buf.data() + size);
+            sink_write(m_sink, buf.data(), size);
+        }
+
+        void write_indefinite_header(const tag& t) {
+            std::array<std::byte, max_encoded_tag_size + 1> buf{};
+            auto size = encode_tag(t, buf.data());
+            buf[size++] = std::byte{0x80u};
+            sink_write(m_sink, buf.data(), size);
+        }
+
+        void write_end_of_contents() {
+            constexpr std::array<std::byte, 2> eoc{};
+            sink_write(m_sink, eoc.data(), eoc.size());
+        }
+
+        void end_constructed() {
+            assert(m_depth > 0);
+            --m_depth;
+            write_end_of_contents();
+        }
+
+        S m_sink;
+        std::size_t m_depth = 0;
+        /**
+         * The held back part of the open string.
+         */
+        std::array<std::byte, segment_size> m_segment{};
+        std::size_t m_fill = 0;
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_CER_ENCODER_H
@@ -0,0 +1,148 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_CHARACTER_STRING_H
+#define DABERS_CHARACTER_STRING_H
+
+#include "dabers/error.h"
+#include "dabers/tag.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace dabers {
+
+    /**
+     * The restricted character string types whose contents can be viewed as chars directly.
+     */
+    enum class string_type : uint8_t {
+        /**
+         * Any well formed UTF-8, without overlong forms or surrogates.
+         */
+        utf8,
+        /**
+         * Digits and space.
+         */
+        numeric,
+        /**
+         * Letters, digits, space and ' ( ) + , - . / : = ?
+         */
+        printable,
+        /**
+         * Any 7 bit character, including the control characters.
+         */
+        ia5,
+        /**
+         * The printing 7 bit characters and space.
+         */
+        visible
+    };
+
+    /**
+     * The string type of a universal tag, e.g. string_type::printable for PrintableString.
+     * @return std::nullopt if the tag isn't one of the universal types above.
+     */
+    constexpr std::optional<string_type> string_type_of(const tag& t) noexcept {
+        if (t.tag_class != tag_class_type::universal) {
+            return std::nullopt;
+        }
+        switch (t.tag_number) {
+            case universal_tags::utf8_string::value.tag_number: return string_type::utf8;
+            case universal_tags::numeric_string::value.tag_number: return string_type::numeric;
+            case universal_tags::printable_string::value.tag_number: return string_type::printable;
+            case universal_tags::ia5_string::value.tag_number: return string_type::ia5;
+            case universal_tags::visible_string::value.tag_number: return string_type::visible;
+            default: return std::nullopt;
+        }
+    }
+
+    /**
+     * Checks every character is allowed by the type.  Long strings are checked 16 or 32
+     * bytes at a time where the target has SSE2/SSSE3/AVX2.
+     */
+    bool is_valid_string(string_type type, std::span<const std::byte> contents) noexcept;
+
+    /**
+     * Validates the contents octets of a primitive string and views them as chars, without
+     * copying.  The view points into the contents, which must outlive it.
+     * @return decode_error::none on success, otherwise decode_error::invalid_utf8 or
+     * decode_error::invalid_string_character.
+     */
+    decode_error try_decode_string(string_type type, std::span<const std::byte> contents, std::string_view& out) noexcept;
+
+    std::string_view decode_string(string_type type, std::span<const std::byte> contents);
+
+    /**
+     * The most UTF-8 octets the contents of a BMPString (UCS-2, big-endian) transcode to.
+     */
+    constexpr std::size_t max_utf8_size_of_bmp(const std::size_t contents_size) noexcept { return contents_size / 2 * 3; }
+
+    /**
+     * The most UTF-8 octets the contents of a UniversalString (UCS-4, big-endian) transcode to.
+     */
+    constexpr std::size_t max_utf8_size_of_universal(const std::size_t contents_size) noexcept { return contents_size / 4 * 4; }
+
+    constexpr std::size_t max_bmp_size_of_utf8(const std::size_t utf8_size) noexcept { return utf8_size * 2; }
+    constexpr std::size_t max_universal_size_of_utf8(const std::size_t utf8_size) noexcept { return utf8_size * 4; }
+
+    /**
+     * Transcodes the contents of a BMPString to UTF-8 in a caller provided buffer, without
+     * allocating.  Runs of ASCII are converted a block at a time.  On failure out and
+     * written are unspecified.
+     * @param contents The contents octets.
+     * @param out Where to put the UTF-8.  max_utf8_size_of_bmp(contents.size()) is always enough.
+     * @param written The number of chars written to out.
+     * @return decode_error::none on success, decode_error::buffer_too_small if out is too
+     * small, decode_error::invalid_string_length if the contents aren't whole characters,
+     * or decode_error::invalid_string_character for a surrogate.
+     */
+    decode_error try_bmp_to_utf8(std::span<const std::byte> contents, std::span<char> out, std::size_t& written) noexcept;
+
+    /**
+     * The same as try_bmp_to_utf8, for UniversalString.  Characters over U+10FFFF and
+     * surrogates are decode_error::invalid_string_character.
+     */
+    decode_error try_universal_to_utf8(std::span<const std::byte> contents, std::span<char> out, std::size_t& written) noexcept;
+
+    /**
+     * Transcodes UTF-8 to the contents of a BMPString in a caller provided buffer.
+     * @param out Where to put the contents.  max_bmp_size_of_utf8(utf8.size()) is always enough.
+     * @return decode_error::none on success, decode_error::buffer_too_small if out is too
+     * small, decode_error::invalid_utf8, or decode_error::invalid_string_character for
+     * characters outside the Basic Multilingual Plane.
+     */
+    decode_error try_utf8_to_bmp(std::string_view utf8, std::span<std::byte> out, std::size_t& written) noexcept;
+
+    decode_error try_utf8_to_universal(std::string_view utf8, std::span<std::byte> out, std::size_t& written) noexcept;
+
+    /**
+     * The most UTF-8 octets try_string_to_utf8 can write for contents with this tag.
+     */
+    constexpr std::size_t max_utf8_size(const tag& t, const std::size_t contents_size) noexcept {
+        if (t.tag_class == tag_class_type::universal && t.tag_number == universal_tags::bmp_string::value.tag_number) {
+            return max_utf8_size_of_bmp(contents_size);
+        }
+        return contents_size;
+    }
+
+    /**
+     * Gets the contents of any of the string types above, or of a BMPString or UniversalString,
+     * as UTF-8 in a caller provided buffer.  The types which already are UTF-8 (or ASCII)
+     * are validated and copied.
+     * @param t The tag of the string, which picks its type.
+     * @return decode_error::unsupported_string_type for other tags,
+     * decode_error::primitive_encoding_required for a constructed (segmented) string,
+     * otherwise as for the type's own function.
+     */
+    decode_error try_string_to_utf8(const tag& t, std::span<const std::byte> contents, std::span<char> out, std::size_t& written) noexcept;
+
+    std::string string_to_utf8(const tag& t, std::span<const std::byte> contents);
+
+} /* namespace dabers */
+
+#endif //DABERS_CHARACTER_STRING_H
@@ -0,0 +1,141 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_CODEC_H
+#define DABERS_CODEC_H
+
+#include "dabers/error.h"
+#include "dabers/header.h"
+#include "dabers/length.h"
+#include "dabers/rules.h"
+#include "dabers/sink.h"
+#include "dabers/skip.h"
+#include "dabers/tag.h"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace dabers {
+
+    /**
+     * One of the rule set tag types (but not the runtime rules enum).
+     */
+    template <typename T>
+    concept static_rule_set = std::same_as<T, ber> || std::same_as<T, cer> || std::same_as<T, der>;
+
+    /**
+     * The decoding and encoding operations for one set of encoding rules, with every rule
+     * specific decision made at compile time.  Code that only ever handles one rule set can
+     * use this directly; code that gets the rules at runtime can go through with_codec once
+     * and then run its whole loop against the static codec.
+     */
+    template <static_rule_set Rules>
+    class codec {
+    public:
+        using rules_type = Rules;
+
+        static constexpr rules runtime_rules = std::same_as<Rules, der> ? rules::der :
+                                               std::same_as<Rules, cer> ? rules::cer : rules::ber;
+
+        /**
+         * Whether a length must use the fewest octets possible.  BER allows any number of
+         * leading zero octets, CER and DER don't.
+         */
+        static constexpr bool minimal_lengths = !std::same_as<Rules, ber>;
+
+        static constexpr length_options decode_length_options(const bool constructed) noexcept {
+            return length_options_for(Rules{}, constructed);
+        }
+
+        static constexpr length_options encode_length_options(const bool constructed) noexcept {
+            return encode_length_options_for(Rules{}, constructed);
+        }
+
+        static decode_error try_parse_header(const std::byte*& begin, const std::byte* const end, tlv_header& out) noexcept {
+            return dabers::try_parse_header(Rules{}, begin, end, out);
+        }
+
+        static tlv_header parse_header(const std::byte*& begin, const std::byte* const end) {
+            return dabers::parse_header(Rules{}, begin, end);
+        }
+
+        static decode_error try_parse_length(const bool constructed, const std::byte*& begin, const std::byte* const end,
+                                             std::optional<uint64_t>& out) noexcept {
+            return dabers::try_parse_length(decode_length_options(constructed), begin, end, out);
+        }
+
+        static decode_error skip_element(const std::byte*& begin, const std::byte* const end) noexcept {
+            return dabers::skip_element(Rules{}, begin, end);
+        }
+
+        static decode_error find_end_of_contents(const std::byte* const contents, const std::byte* const end,
+                                                 const std::byte*& eoc) noexcept {
+            if constexpr (std::same_as<Rules, der>) {
+                return decode_error::indefinite_length_forbidden;
+            }
+            else {
+                return dabers::find_end_of_contents(Rules{}, contents, end, eoc);
+            }
+        }
+
+        /**
+         * Checks the parts of a parsed header these rules are stricter about than the parser
+         * is.  The parser already enforces which length forms are allowed; this adds the
+         * requirement for minimal length octets under CER and DER.
+         * @return decode_error::none if the header is valid for these rules.
+         */
+        static constexpr decode_error validate_header(const tlv_header& h) noexcept {
+            if constexpr (minimal_lengths) {
+                if (h.length && h.header_size != encoded_tag_size(h.id) + encoded_length_size(*h.length)) {
+                    return decode_error::non_minimal_length;
+                }
+            }
+            return decode_error::none;
+        }
+
+        /**
+         * Writes identifier and length octets.  Constructed elements get the indefinite form
+         * under CER, in which case len is ignored and the caller has to write the
+         * end-of-contents octets after the contents.
+         * @return True if the indefinite form was written.
+         */
+        template <typename S>
+            requires byte_sink<std::remove_cvref_t<S>>
+        static bool write_header(const tag& t, const uint64_t len, S&& output) {
+            std::array<std::byte, max_encoded_tag_size + max_encoded_length_size> buf{};
+            auto size = encode_tag(t, buf.data());
+            const bool indefinite = encode_length_options(t.constructed) == length_options::indefinite_required;
+            if (indefinite) {
+                buf[size++] = std::byte{0x80u};
+            }
+            else {
+                size += encode_length(len, buf.data() + size);
+            }
+            sink_write(output, buf.data(), size);
+            return indefinite;
+        }
+    };
+
+    /**
+     * The one place a runtime rules value is turned into a static codec.
+     * @param r The rules to use.
+     * @param f Called with codec<ber>, codec<cer> or codec<der>; all three must return the same type.
+     * @return Whatever f returns.
+     */
+    template <typename F>
+    constexpr decltype(auto) with_codec(const rules r, F&& f) {
+        switch (r) {
+            case rules::cer: return std::forward<F>(f)(codec<cer>{});
+            case rules::der: return std::forward<F>(f)(codec<der>{});
+            default: return std::forward<F>(f)(codec<ber>{});
+        }
+    }
+
+} /* namespace dabers */
+
+#endif //DABERS_CODEC_H
@@ -7,7 +7,27 @@
 
 #include "doctest/doctest.h"
 
+#include "dabers/error.h"
+#include "dabers/sink.h"
 #include "dabers/tag.h"
+#include "dabers/length.h"
+#include "dabers/header.h"
+#include "dabers/integer.h"
+#include "dabers/oid.h"
+#include "dabers/character_string.h"
+#include "dabers/time.h"
+#include "dabers/codec.h"
+#include "dabers/skip.h"
+#include "dabers/validate.h"
+#include "dabers/tlv_view.h"
+#include "dabers/tape.h"
+#include "dabers/tree.h"
+#include "dabers/push_parser.h"
+#include "dabers/der_encoder.h"
+#include "dabers/der_set_of.h"
+#include "dabers/cer_encoder.h"
+#include "dabers/mapped_file.h"
+#include "dabers/parallel.h"
 
 namespace dabers {
 
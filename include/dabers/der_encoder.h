@@ -0,0 +1,183 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_DER_ENCODER_H
+#define DABERS_DER_ENCODER_H
+
+#include "dabers/length.h"
+#include "dabers/tag.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <span>
+#include <vector>
+
+namespace dabers {
+
+    /**
+     * Encodes DER by writing from the end of the buffer towards the front.  When a
+     * constructed element is closed the size of its contents is already known, so its
+     * definite length can be written without encoding the contents somewhere else first.
+     * The catch is that everything has to be written in reverse: the last child of a
+     * constructed element is written first, and the element's scope is opened before any
+     * of its children are written and closed after all of them.
+     *
+     *     der_encoder enc;
+     *     {
+     *         auto seq = enc.constructed(universal_tags::sequence::value);
+     *         enc.write_primitive(universal_tags::boolean::value, second_child);
+     *         enc.write_primitive(universal_tags::integer::value, first_child);
+     *     }
+     *     auto der = enc.release();
+     */
+    class der_encoder {
+    public:
+        /**
+         * Closes a constructed element when it is destroyed, or when close() is called.
+         * Scopes must be closed in the reverse order they were opened, which RAII gives you.
+         * Room for the header is reserved when the scope is opened, so closing it never
+         * allocates and can't throw.  A scope destroyed while an exception is unwinding the
+         * stack writes nothing, since its contents are probably incomplete;  the encoder
+         * should be cleared or discarded after that.
+         */
+        class scope {
+        public:
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+            scope(scope&& other) noexcept :
+                m_encoder{other.m_encoder}, m_tag{other.m_tag}, m_start{other.m_start}, m_exceptions{other.m_exceptions} {
+                other.m_encoder = nullptr;
+            }
+            scope& operator=(scope&&) = delete;
+            ~scope() {
+                if (m_encoder && std::uncaught_exceptions() > m_exceptions) {
+                    m_encoder->m_reserved -= max_header_size;
+                    m_encoder = nullptr;
+                }
+                close();
+            }
+
+            void close() noexcept {
+                if (m_encoder) {
+                    m_encoder->close_scope(m_tag, m_encoder->size() - m_start);
+                    m_encoder = nullptr;
+                }
+            }
+
+        private:
+            friend class der_encoder;
+            scope(der_encoder& enc, const tag& t) noexcept :
+                m_encoder{&enc}, m_tag{t}, m_start{enc.size()}, m_exceptions{std::uncaught_exceptions()} {}
+
+            der_encoder* m_encoder;
+            tag m_tag;
+            std::size_t m_start;
+            int m_exceptions;
+        };
+
+        der_encoder() = default;
+        explicit der_encoder(std::size_t initial_capacity) : m_buf(initial_capacity), m_begin{initial_capacity} {}
+
+        /**
+         * Opens a constructed element.  Everything written until the scope is closed becomes its contents.
+         * @param t The tag, which will be marked as constructed.
+         */
+        [[nodiscard]] scope constructed(tag t) {
+            t.constructed = true;
+            if (m_reserved + max_header_size > m_begin) {
+                grow(max_header_size);
+            }
+            m_reserved += max_header_size;
+            return scope{*this, t};
+        }
+
+        /**
+         * Writes a primitive element.
+         * @param t The tag, which will be marked as primitive.
+         * @param contents The contents octets.
+         */
+        void write_primitive(tag t, std::span<const std::byte> contents) {
+            t.constructed = false;
+            prepend(contents.data(), contents.size());
+            write_header(t, contents.size());
+        }
+
+        /**
+         * Writes contents octets without a header, e.g. when they're produced in pieces.
+         * Follow with write_header, or write them inside a scope.
+         */
+        void write_contents(std::span<const std::byte> contents) {
+            prepend(contents.data(), contents.size());
+        }
+
+        /**
+         * Writes an already encoded element (or several of them).
+         */
+        void write_encoded(std::span<const std::byte> encoded) {
+            prepend(encoded.data(), encoded.size());
+        }
+
+        /**
+         * Writes identifier and length octets in front of everything written so far.
+         */
+        void write_header(const tag& t, uint64_t length);
+
+        [[nodiscard]] std::span<const std::byte> data() const noexcept {
+            return {m_buf.data() + m_begin, m_buf.size() - m_begin};
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return m_buf.size() - m_begin; }
+
+        /**
+         * Gives up the encoded bytes, moving them to the front of the buffer, which is the
+         * only time they are moved.  The encoder is empty afterwards.
+         */
+        std::vector<std::byte> release();
+
+        /**
+         * Discards everything, keeping the buffer for reuse.  Any scopes still open must be
+         * gone first.
+         */
+        void clear() noexcept {
+            m_begin = m_buf.size();
+            m_reserved = 0;
+        }
+
+    private:
+        static constexpr std::size_t max_header_size = max_encoded_tag_size + max_encoded_length_size;
+
+        void prepend(const std::byte* data, std::size_t size) {
+            if (size + m_reserved > m_begin) {
+                grow(size);
+            }
+            m_begin -= size;
+            if (size != 0) {
+                std::memcpy(m_buf.data() + m_begin, data, size);
+            }
+        }
+
+        /**
+         * Writes the header of a scope into the room reserved for it.
+         */
+        void close_scope(const tag& t, uint64_t length) noexcept;
+
+        /**
+         * Makes room for needed more bytes on top of those reserved.
+         */
+        void grow(std::size_t needed);
+
+        /**
+         * The encoded bytes are m_buf[m_begin, m_buf.size()); everything before is free space,
+         * of which m_reserved bytes are kept for the headers of the open scopes.
+         */
+        std::vector<std::byte> m_buf;
+        std::size_t m_begin = 0;
+        std::size_t m_reserved = 0;
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_DER_ENCODER_H
@@ -0,0 +1,127 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_DER_SET_OF_H
+#define DABERS_DER_SET_OF_H
+
+#include "dabers/der_encoder.h"
+#include "dabers/length.h"
+#include "dabers/sink.h"
+#include "dabers/tag.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dabers {
+
+    /**
+     * Collects the encoded components of a SET OF and writes them out in the order DER
+     * requires: ascending by their encodings, with shorter encodings compared as though
+     * padded with trailing zero octets (X.690 11.6).
+     *
+     * Components are appended to one buffer as they're added and only index entries are
+     * sorted, with an MSD radix sort over the octets, so the payload bytes are copied once
+     * on the way in and once when the set is written.
+     *
+     *     der_set_of set;
+     *     for (const auto& attr : attributes) {
+     *         set.add(encode(attr));
+     *     }
+     *     set.write(enc);
+     */
+    class der_set_of {
+    public:
+        der_set_of() = default;
+
+        /**
+         * Adds one complete encoded component.
+         */
+        void add(std::span<const std::byte> encoded) {
+            m_entries.push_back({m_data.size(), encoded.size()});
+            m_data.insert(m_data.end(), encoded.begin(), encoded.end());
+            m_sorted = m_entries.size() < 2;
+        }
+
+        /**
+         * Sorts the components into DER order.  Writing sorts first if needed, so this only
+         * needs calling to look at the sorted components with operator[].
+         */
+        void sort();
+
+        [[nodiscard]] std::size_t size() const noexcept { return m_entries.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_entries.empty(); }
+
+        /**
+         * The total size of the components, i.e. the length of the SET's contents.
+         */
+        [[nodiscard]] std::size_t contents_size() const noexcept { return m_data.size(); }
+
+        /**
+         * The i'th component, in the order they were added or, after sort(), in DER order.
+         */
+        [[nodiscard]] std::span<const std::byte> operator[](std::size_t i) const noexcept {
+            return {m_data.data() + m_entries[i].offset, m_entries[i].size};
+        }
+
+        /**
+         * Writes the sorted components, wrapped in a SET (or another tag for an implicitly
+         * tagged SET OF), in front of what's already in the encoder.
+         */
+        void write(der_encoder& enc, tag t = universal_tags::set::value);
+
+        /**
+         * Writes the sorted components, wrapped in a SET (or another tag), to a sink.
+         */
+        template <typename S>
+            requires byte_sink<std::remove_cvref_t<S>>
+        void write(S&& output, tag t = universal_tags::set::value) {
+            sort();
+            t.constructed = true;
+            std::array<std::byte, max_encoded_tag_size + max_encoded_length_size> buf{};
+            auto size = encode_tag(t, buf.data());
+            size += encode_length(m_data.size(), buf.data() + size);
+            sink_write(output, buf.data(), size);
+            for (const auto& e : m_entries) {
+                sink_write(output, m_data.data() + e.offset, e.size);
+            }
+        }
+
+        /**
+         * Removes every component, keeping the storage for reuse.
+         */
+        void clear() noexcept {
+            m_data.clear();
+            m_entries.clear();
+            m_sorted = true;
+        }
+
+    private:
+        struct entry {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        /**
+         * A run of entries sorted on everything before depth, still to be sorted from depth on.
+         */
+        struct pending_range {
+            std::size_t begin;
+            std::size_t end;
+            std::size_t depth;
+        };
+
+        std::vector<std::byte> m_data;
+        std::vector<entry> m_entries;
+        //Kept between sorts so a reused set doesn't allocate.
+        std::vector<entry> m_scratch;
+        std::vector<pending_range> m_pending;
+        bool m_sorted = true;
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_DER_SET_OF_H
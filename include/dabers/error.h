@@ -0,0 +1,58 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_ERROR_H
+#define DABERS_ERROR_H
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace dabers {
+
+    /**
+     * Error codes reported by the non-throwing (try_*) decoding functions.  The
+     * throwing functions report the same conditions through dabers::exception.
+     */
+    enum class decode_error : uint8_t {
+        none = 0,
+        null_buffer,
+        buffer_too_small,
+        tag_number_leading_zero,
+        tag_number_too_long,
+        tag_number_too_small,
+        indefinite_length_forbidden,
+        indefinite_length_required,
+        length_too_long,
+        too_many_elements,
+        non_minimal_length,
+        empty_integer,
+        non_minimal_integer,
+        integer_out_of_range,
+        empty_oid,
+        truncated_oid,
+        oid_arc_leading_zero,
+        oid_arc_too_long,
+        invalid_string_character,
+        invalid_utf8,
+        invalid_string_length,
+        unsupported_string_type,
+        invalid_time,
+        non_canonical_time,
+        unexpected_end_of_contents,
+        primitive_encoding_required,
+        constructed_encoding_required,
+        invalid_boolean,
+        invalid_null,
+        invalid_bit_string,
+        set_out_of_order,
+        nesting_too_deep
+    };
+
+    std::string_view to_string(decode_error e) noexcept;
+    std::ostream& operator<<(std::ostream& os, decode_error e);
+
+} /* namespace dabers */
+
+#endif //DABERS_ERROR_H
@@ -0,0 +1,79 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_HEADER_H
+#define DABERS_HEADER_H
+
+#include "dabers/error.h"
+#include "dabers/rules.h"
+#include "dabers/tag.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace dabers {
+
+    /**
+     * The identifier and length octets of a single TLV element, along with where its contents are.
+     */
+    struct tlv_header {
+        tag id;
+        /**
+         * The length of the contents, or std::nullopt for the indefinite form.
+         */
+        std::optional<uint64_t> length;
+        /**
+         * The number of identifier and length octets.
+         */
+        std::size_t header_size = 0;
+        /**
+         * The contents octets.  For the indefinite form the end of the contents isn't known
+         * from the header, so this is everything from the end of the header to the end of
+         * the buffer, including the end-of-contents octets.
+         */
+        std::span<const std::byte> contents;
+
+        [[nodiscard]] bool indefinite() const noexcept { return !length.has_value(); }
+    };
+
+    /**
+     * Parses the identifier and length octets of an element in a single pass and without
+     * throwing.  For definite lengths the contents must be entirely inside the buffer.  On
+     * success begin is moved to the start of the contents, on failure it is left untouched
+     * and out is unspecified.
+     * @param r The rules which determine which length forms are allowed.
+     * @param begin The start of the buffer.
+     * @param end The end of the buffer.
+     * @param out The parsed header.
+     * @return decode_error::none on success, otherwise the reason the header could not be parsed.
+     */
+    decode_error try_parse_header(rules r, const std::byte*& begin, const std::byte* end, tlv_header& out) noexcept;
+
+    /**
+     * The same as the rules overload, but with the rules fixed at compile time so the
+     * length form checks are folded into the decoder.
+     */
+    decode_error try_parse_header(ber, const std::byte*& begin, const std::byte* end, tlv_header& out) noexcept;
+    decode_error try_parse_header(cer, const std::byte*& begin, const std::byte* end, tlv_header& out) noexcept;
+    decode_error try_parse_header(der, const std::byte*& begin, const std::byte* end, tlv_header& out) noexcept;
+
+    tlv_header parse_header(rules r, const std::byte*& begin, const std::byte* end);
+
+    inline tlv_header parse_header(ber, const std::byte*& begin, const std::byte* const end) {
+        return parse_header(rules::ber, begin, end);
+    }
+
+    inline tlv_header parse_header(cer, const std::byte*& begin, const std::byte* const end) {
+        return parse_header(rules::cer, begin, end);
+    }
+
+    inline tlv_header parse_header(der, const std::byte*& begin, const std::byte* const end) {
+        return parse_header(rules::der, begin, end);
+    }
+
+} /* namespace dabers */
+
+#endif //DABERS_HEADER_H
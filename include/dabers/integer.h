@@ -0,0 +1,199 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_INTEGER_H
+#define DABERS_INTEGER_H
+
+#include "dabers/error.h"
+#include "dabers/length.h"
+#include "dabers/sink.h"
+#include "dabers/tag.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace dabers {
+
+    namespace detail {
+
+        constexpr uint32_t load_be32(const std::byte* const p) noexcept {
+            return (std::to_integer<uint32_t>(p[0]) << 24) | (std::to_integer<uint32_t>(p[1]) << 16) |
+                   (std::to_integer<uint32_t>(p[2]) << 8) | std::to_integer<uint32_t>(p[3]);
+        }
+
+        /**
+         * Reads 1 to 8 big-endian octets without looping over them:  two overlapping 4 octet
+         * loads cover 4 to 8 octets, and the first, middle and last octets cover 1 to 3.
+         */
+        constexpr uint64_t load_be_small(const std::byte* const p, const std::size_t n) noexcept {
+            if (n >= 4) {
+                return (uint64_t{load_be32(p)} << ((n - 4) * 8)) | load_be32(p + n - 4);
+            }
+            return (std::to_integer<uint64_t>(p[0]) << ((n - 1) * 8)) |
+                   (std::to_integer<uint64_t>(p[n / 2]) << ((n - 1 - n / 2) * 8)) |
+                   std::to_integer<uint64_t>(p[n - 1]);
+        }
+
+        constexpr decode_error check_integer(const std::span<const std::byte> contents) noexcept {
+            if (contents.empty()) {
+                return decode_error::empty_integer;
+            }
+            else if (contents.size() > 1) {
+                const auto top = (std::to_integer<unsigned int>(contents[0]) << 1) | (std::to_integer<unsigned int>(contents[1]) >> 7);
+                if (top == 0 || top == 0x1ffu) {
+                    return decode_error::non_minimal_integer;
+                }
+            }
+            return decode_error::none;
+        }
+
+    } /* namespace detail */
+
+    /**
+     * Decodes the contents octets of an INTEGER.  The contents must be at least one octet
+     * and minimal (the first nine bits mustn't all be the same, X.690 8.3.2), which holds
+     * for all of BER, CER and DER.
+     * @param contents The contents octets.
+     * @param out The value.
+     * @return decode_error::none on success, decode_error::integer_out_of_range if the
+     * value doesn't fit, or the reason the encoding is invalid.
+     */
+    constexpr decode_error try_decode_integer(const std::span<const std::byte> contents, int64_t& out) noexcept {
+        if (auto err = detail::check_integer(contents); err != decode_error::none) {
+            return err;
+        }
+        else if (contents.size() > sizeof(int64_t)) {
+            return decode_error::integer_out_of_range;
+        }
+        //Move the value to the top, then an arithmetic shift back down sign extends it.
+        const auto shift = (sizeof(int64_t) - contents.size()) * 8;
+        out = static_cast<int64_t>(detail::load_be_small(contents.data(), contents.size()) << shift) >> shift;
+        return decode_error::none;
+    }
+
+    constexpr decode_error try_decode_integer(std::span<const std::byte> contents, uint64_t& out) noexcept {
+        if (auto err = detail::check_integer(contents); err != decode_error::none) {
+            return err;
+        }
+        else if ((contents.front() & std::byte{0x80u}) != std::byte{0}) {
+            return decode_error::integer_out_of_range;
+        }
+        else if (contents.size() == sizeof(uint64_t) + 1 && contents.front() == std::byte{0}) {
+            //Only the zero octet which keeps the top bit from being the sign.
+            contents = contents.subspan(1);
+        }
+        else if (contents.size() > sizeof(uint64_t)) {
+            return decode_error::integer_out_of_range;
+        }
+        out = detail::load_be_small(contents.data(), contents.size());
+        return decode_error::none;
+    }
+
+    int64_t decode_integer(std::span<const std::byte> contents);
+
+    /**
+     * The most contents octets encode_integer writes:  a uint64_t over 2^63 needs a leading zero octet.
+     */
+    constexpr std::size_t max_encoded_integer_size = 9;
+
+    /**
+     * The number of contents octets in the minimal two's complement encoding of v.
+     */
+    constexpr std::size_t encoded_integer_size(const int64_t v) noexcept {
+        //The bits which differ from the sign, plus one for the sign bit, rounded up to octets.
+        const auto magnitude = static_cast<uint64_t>(v < 0 ? ~v : v);
+        return static_cast<std::size_t>(std::bit_width(magnitude)) / 8 + 1;
+    }
+
+    constexpr std::size_t encoded_integer_size(const uint64_t v) noexcept {
+        return static_cast<std::size_t>(std::bit_width(v)) / 8 + 1;
+    }
+
+    /**
+     * Writes the minimal two's complement contents octets of an INTEGER.
+     * @param out Where to put the contents octets, which must have room for max_encoded_integer_size bytes.
+     * @return The number of bytes written to out.
+     */
+    std::size_t encode_integer(int64_t v, std::byte* out) noexcept;
+    std::size_t encode_integer(uint64_t v, std::byte* out) noexcept;
+
+    /**
+     * Writes a whole INTEGER element.
+     * @param t The tag, universal INTEGER unless implicitly tagged.
+     */
+    template <typename T, typename S>
+        requires (std::same_as<T, int64_t> || std::same_as<T, uint64_t>) && byte_sink<std::remove_cvref_t<S>>
+    void write_integer(const T v, S&& output, const tag& t = universal_tags::integer::value) {
+        std::array<std::byte, max_encoded_tag_size + max_encoded_length_size + max_encoded_integer_size> buf{};
+        auto size = encode_tag(t, buf.data());
+        //The contents never need more than one length octet.
+        const auto len_at = size++;
+        const auto len = encode_integer(v, buf.data() + size);
+        buf[len_at] = std::byte{static_cast<uint8_t>(len)};
+        sink_write(output, buf.data(), size + len);
+    }
+
+    /**
+     * An INTEGER of any size, viewed in place.  Nothing is copied, which suits RSA moduli,
+     * exponents and serial numbers that only need inspecting or passing on as bytes.
+     */
+    class big_integer_view {
+    public:
+        big_integer_view() = default;
+
+        /**
+         * Checks the contents octets are a valid INTEGER encoding and views them.
+         * @return decode_error::none on success, otherwise the reason the encoding is invalid.
+         */
+        static constexpr decode_error from_contents(const std::span<const std::byte> contents, big_integer_view& out) noexcept {
+            if (auto err = detail::check_integer(contents); err != decode_error::none) {
+                return err;
+            }
+            out.m_bytes = contents;
+            return decode_error::none;
+        }
+
+        [[nodiscard]] constexpr bool negative() const noexcept {
+            return !m_bytes.empty() && (m_bytes.front() & std::byte{0x80u}) != std::byte{0};
+        }
+
+        /**
+         * The two's complement value, big-endian, exactly as encoded.
+         */
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return m_bytes; }
+
+        /**
+         * For a non-negative value, the big-endian unsigned value without the leading zero
+         * octet which keeps the sign bit clear, i.e. what crypto libraries take for a
+         * modulus.  Empty for zero.  For negative values this is the same as bytes().
+         */
+        [[nodiscard]] std::span<const std::byte> magnitude() const noexcept {
+            return !m_bytes.empty() && m_bytes.front() == std::byte{0} ? m_bytes.subspan(1) : m_bytes;
+        }
+
+        /**
+         * The number of significant bits of a non-negative value, e.g. 2048 for a 2048 bit modulus.
+         */
+        [[nodiscard]] std::size_t bit_width() const noexcept {
+            const auto m = magnitude();
+            return m.empty() ? 0 : (m.size() - 1) * 8 + static_cast<std::size_t>(std::bit_width(std::to_integer<unsigned int>(m.front())));
+        }
+
+        /**
+         * Converts to a fixed size integer.
+         * @return decode_error::integer_out_of_range if it doesn't fit.
+         */
+        constexpr decode_error to(int64_t& out) const noexcept { return try_decode_integer(m_bytes, out); }
+        constexpr decode_error to(uint64_t& out) const noexcept { return try_decode_integer(m_bytes, out); }
+
+    private:
+        std::span<const std::byte> m_bytes;
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_INTEGER_H
@@ -6,6 +6,12 @@
 #define DABERS_LENGTH_H
 
 #include "dabers/rules.h"
+#include "dabers/error.h"
+#include "dabers/sink.h"
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <concepts>
@@ -19,85 +25,174 @@ namespace dabers {
         definite_required
     };
 
-    std::optional<uint64_t> parse_length(length_options opts, const std::byte*& begin, const std::byte* end);
-
-    std::optional<uint64_t> parse_length(ber, bool constructed, const std::byte*& begin, const std::byte* const end) {
-        return parse_length(constructed ? length_options::indefinite_optional : length_options::definite_required,
-                            begin, end);
+    constexpr length_options length_options_for(ber, bool constructed) noexcept {
+        return constructed ? length_options::indefinite_optional : length_options::definite_required;
     }
 
-    std::optional<uint64_t> parse_length(cer, bool constructed, const std::byte*& begin, const std::byte* const end) {
-        return parse_length(constructed ? length_options::indefinite_required : length_options::definite_required,
-                            begin, end);
+    constexpr length_options length_options_for(cer, bool constructed) noexcept {
+        return constructed ? length_options::indefinite_required : length_options::definite_required;
     }
 
-    std::optional<uint64_t> parse_length(der, bool constructed, const std::byte*& begin, const std::byte* const end) {
-        return parse_length(length_options::definite_required, begin, end);
+    constexpr length_options length_options_for(der, bool) noexcept {
+        return length_options::definite_required;
     }
 
-    std::optional<uint64_t> parse_length(rules r, bool constructed, const std::byte*& begin, const std::byte* const end) {
+    /**
+     * For one-off lookups with runtime rules.  Loops over many elements should resolve the
+     * rules once with with_codec and use codec<Rules>::decode_length_options.
+     */
+    constexpr length_options length_options_for(rules r, bool constructed) noexcept {
         switch (r) {
-            case rules::cer: return parse_length(cer{}, constructed, begin, end);
-            case rules::der: return parse_length(der{}, constructed, begin, end);
-            default: return parse_length(ber{}, constructed, begin, end);
+            case rules::cer: return length_options_for(cer{}, constructed);
+            case rules::der: return length_options_for(der{}, constructed);
+            default: return length_options_for(ber{}, constructed);
         }
     }
 
+    /**
+     * Parses length octets without throwing.  On success begin is moved past the length
+     * octets, on failure it is left untouched and out is unspecified.
+     * @param opts Which length forms are acceptable.
+     * @param begin The start of the buffer.
+     * @param end The end of the buffer.
+     * @param out The parsed length, or std::nullopt for the indefinite form.
+     * @return decode_error::none on success, otherwise the reason the length could not be parsed.
+     */
+    decode_error try_parse_length(length_options opts, const std::byte*& begin, const std::byte* end, std::optional<uint64_t>& out) noexcept;
+
+    template <typename Rules>
+    decode_error try_parse_length(Rules r, bool constructed, const std::byte*& begin, const std::byte* const end, std::optional<uint64_t>& out) noexcept {
+        return try_parse_length(length_options_for(r, constructed), begin, end, out);
+    }
 
-    bool write_length(uint64_t len, length_options opts, const std::function<void(std::byte)>& output);
+    std::optional<uint64_t> parse_length(length_options opts, const std::byte*& begin, const std::byte* end);
 
-    template <std::output_iterator<std::byte> Iter>
-    bool write_length(ber, bool, uint64_t len, Iter output) {
-        return write_length(len, length_options::definite_required,
-                            [&output](std::byte b){ *output = b; ++output; });
+    inline std::optional<uint64_t> parse_length(ber, bool constructed, const std::byte*& begin, const std::byte* const end) {
+        return parse_length(length_options_for(ber{}, constructed), begin, end);
     }
 
-    template <std::output_iterator<std::byte> Iter>
-    bool write_length(cer, bool constructed, uint64_t len, Iter output) {
-        return write_length(len, constructed ? length_options::indefinite_required : length_options::definite_required,
-                            [&output](std::byte b){ *output = b; ++output; });
+    inline std::optional<uint64_t> parse_length(cer, bool constructed, const std::byte*& begin, const std::byte* const end) {
+        return parse_length(length_options_for(cer{}, constructed), begin, end);
     }
 
-    template <std::output_iterator<std::byte> Iter>
-    bool write_length(der, bool, uint64_t len, Iter output) {
-        return write_length(len, length_options::definite_required,
-                            [&output](std::byte b){ *output = b; ++output; });
+    inline std::optional<uint64_t> parse_length(der, bool constructed, const std::byte*& begin, const std::byte* const end) {
+        return parse_length(length_options_for(der{}, constructed), begin, end);
     }
 
-    template <std::output_iterator<std::byte> Iter>
-    bool write_length(rules r, bool constructed, uint64_t len, Iter output) {
-        switch (r) {
-            case rules::cer: return write_length(cer{}, constructed, output);
-            case rules::der: return write_length(der{}, constructed, output);
-            default: return write_length(ber{}, constructed, output);
-        }
+    inline std::optional<uint64_t> parse_length(rules r, bool constructed, const std::byte*& begin, const std::byte* const end) {
+        return parse_length(length_options_for(r, constructed), begin, end);
     }
 
-    template <std::integral T, std::output_iterator<T> Iter>
-    bool write_length(ber, bool, uint64_t len, Iter output) {
-        return write_length(len, length_options::definite_required,
-                            [&output](std::byte b){ *output = static_cast<T>(b); ++output; });
+
+    constexpr length_options encode_length_options_for(ber, bool) noexcept {
+        return length_options::definite_required;
     }
 
-    template <std::integral T, std::output_iterator<T> Iter>
-    bool write_length(cer, bool constructed, uint64_t len, Iter output) {
-        return write_length(len, constructed ? length_options::indefinite_required : length_options::definite_required,
-                            [&output](std::byte b){ *output = static_cast<T>(b); ++output; });
+    constexpr length_options encode_length_options_for(cer, bool constructed) noexcept {
+        return constructed ? length_options::indefinite_required : length_options::definite_required;
     }
 
-    template <std::integral T, std::output_iterator<T> Iter>
-    bool write_length(der, bool, uint64_t len, Iter output) {
-        return write_length(len, length_options::definite_required,
-                            [&output](std::byte b){ *output = static_cast<T>(b); ++output; });
+    constexpr length_options encode_length_options_for(der, bool) noexcept {
+        return length_options::definite_required;
     }
 
-    template <std::integral T, std::output_iterator<T> Iter>
-    bool write_length(rules r, bool constructed, uint64_t len, Iter output) {
+    /**
+     * For one-off lookups with runtime rules, as length_options_for.
+     */
+    constexpr length_options encode_length_options_for(rules r, bool constructed) noexcept {
         switch (r) {
-            case rules::cer: return write_length(cer{}, constructed, output);
-            case rules::der: return write_length(der{}, constructed, output);
-            default: return write_length(ber{}, constructed, output);
+            case rules::cer: return encode_length_options_for(cer{}, constructed);
+            case rules::der: return encode_length_options_for(der{}, constructed);
+            default: return encode_length_options_for(ber{}, constructed);
+        }
+    }
+
+    /**
+     * The most octets definite length octets can take:  the initial octet plus up to eight
+     * octets for a 64-bit length.
+     */
+    constexpr std::size_t max_encoded_length_size = 9;
+
+    /**
+     * The number of octets encode_length produces for a definite length.
+     */
+    constexpr std::size_t encoded_length_size(uint64_t len) noexcept {
+        return len < 128 ? 1 : 1 + static_cast<std::size_t>((std::bit_width(len) + CHAR_BIT - 1) / CHAR_BIT);
+    }
+
+    /**
+     * Encodes a definite length using the minimal number of octets, as required by DER
+     * and always valid for BER and CER.
+     * @param len The length to encode.
+     * @param out Where to put the encoded length, which must have room for max_encoded_length_size bytes.
+     * @return The number of bytes written to out.
+     */
+    constexpr std::size_t encode_length(uint64_t len, std::byte* out) noexcept {
+        if (len < 128) {
+            out[0] = std::byte{static_cast<uint8_t>(len)};
+            return 1;
+        }
+        const auto num_len = static_cast<std::size_t>((std::bit_width(len) + CHAR_BIT - 1) / CHAR_BIT);
+        out[0] = std::byte{static_cast<uint8_t>(0x80u | num_len)};
+        for (std::size_t i = num_len; i > 0; --i) {
+            out[i] = std::byte{static_cast<uint8_t>(len)};
+            len >>= CHAR_BIT;
         }
+        return num_len + 1;
+    }
+
+    namespace detail {
+        [[noreturn]] void throw_invalid_length_option(length_options opts, uint64_t len);
+    } /* namespace detail */
+
+    /**
+     * Writes length octets.
+     * @param len The length to write, ignored if the indefinite form is written.
+     * @param opts Either length_options::indefinite_required or length_options::definite_required.
+     * @param output The sink to write to.  Contiguous sinks get the whole length in a single write.
+     * @return True if the indefinite form was written, false otherwise.
+     */
+    template <typename S>
+        requires byte_sink<std::remove_cvref_t<S>>
+    bool write_length(uint64_t len, length_options opts, S&& output) {
+        if (opts == length_options::indefinite_required) {
+            output.put(std::byte{0x80u});
+            return true;
+        }
+        else if (opts == length_options::definite_required) {
+            if (len < 128) {
+                output.put(std::byte{static_cast<uint8_t>(len)});
+            }
+            else {
+                std::array<std::byte, max_encoded_length_size> buf{};
+                sink_write(output, buf.data(), encode_length(len, buf.data()));
+            }
+            return false;
+        }
+        detail::throw_invalid_length_option(opts, len);
+    }
+
+    bool write_length(uint64_t len, length_options opts, const std::function<void(std::byte)>& output);
+
+    template <std::invocable<std::byte> F>
+    bool write_length(uint64_t len, length_options opts, F&& output) {
+        return write_length(len, opts, function_sink<std::remove_reference_t<F>>{output});
+    }
+
+    template <rule_set Rules, typename S>
+        requires byte_sink<std::remove_cvref_t<S>>
+    bool write_length(Rules r, bool constructed, uint64_t len, S&& output) {
+        return write_length(len, encode_length_options_for(r, constructed), std::forward<S>(output));
+    }
+
+    template <rule_set Rules, std::output_iterator<std::byte> Iter>
+    bool write_length(Rules r, bool constructed, uint64_t len, Iter output) {
+        return write_length(len, encode_length_options_for(r, constructed), iterator_sink<Iter>{std::move(output)});
+    }
+
+    template <std::integral T, rule_set Rules, std::output_iterator<T> Iter>
+    bool write_length(Rules r, bool constructed, uint64_t len, Iter output) {
+        return write_length(len, encode_length_options_for(r, constructed), iterator_sink<Iter, T>{std::move(output)});
     }
 
 } /* namespace dabers */
@@ -0,0 +1,74 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_MAPPED_FILE_H
+#define DABERS_MAPPED_FILE_H
+
+#include "dabers/rules.h"
+#include "dabers/tlv_view.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace dabers {
+
+    /**
+     * A read-only memory mapping of a whole file, so records can be decoded straight from
+     * the page cache without being read into a buffer first.  Files larger than 4 GiB are
+     * supported on 64-bit platforms.
+     */
+    class mapped_file {
+    public:
+        enum class access_pattern : uint8_t {
+            normal,
+            sequential,
+            random
+        };
+
+        mapped_file() = default;
+
+        /**
+         * Maps a file, throwing dabers::exception if it can't be opened or mapped.
+         * @param path The file to map.
+         * @param pattern How the file is going to be read, passed on to the OS as a hint.
+         * Sequential access gets aggressive readahead.
+         */
+        explicit mapped_file(const std::filesystem::path& path, access_pattern pattern = access_pattern::sequential);
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+        mapped_file(mapped_file&& other) noexcept;
+        mapped_file& operator=(mapped_file&& other) noexcept;
+        ~mapped_file();
+
+        /**
+         * Changes the access pattern hint for the whole mapping.
+         */
+        void advise(access_pattern pattern) const noexcept;
+
+        void close() noexcept;
+
+        [[nodiscard]] std::span<const std::byte> data() const noexcept { return {m_data, static_cast<std::size_t>(m_size)}; }
+        [[nodiscard]] uint64_t size() const noexcept { return m_size; }
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+        /**
+         * The top-level elements of the file, for archives of concatenated records.
+         */
+        [[nodiscard]] tlv_view records(rules r = rules::ber) const noexcept { return tlv_view{data(), r}; }
+
+    private:
+        const std::byte* m_data = nullptr;
+        uint64_t m_size = 0;
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_MAPPED_FILE_H
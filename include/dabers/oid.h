@@ -0,0 +1,458 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_OID_H
+#define DABERS_OID_H
+
+#include "dabers/error.h"
+#include "dabers/integer.h"
+#include "dabers/length.h"
+#include "dabers/sink.h"
+#include "dabers/tag.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dabers {
+
+    /**
+     * The most octets one arc takes:  a 64 bit value in 7 bit groups.
+     */
+    constexpr std::size_t max_encoded_arc_size = 10;
+
+    /**
+     * The number of octets in the base-128 encoding of one subidentifier.
+     */
+    constexpr std::size_t encoded_arc_size(const uint64_t v) noexcept {
+        return v == 0 ? 1 : (static_cast<std::size_t>(std::bit_width(v)) + 6) / 7;
+    }
+
+    /**
+     * Writes one subidentifier in base-128, most significant group first.
+     * @param out Where to put it, which must have room for max_encoded_arc_size bytes.
+     * @return The number of bytes written to out.
+     */
+    constexpr std::size_t encode_arc(uint64_t v, std::byte* const out) noexcept {
+        const auto n = encoded_arc_size(v);
+        out[n - 1] = std::byte{static_cast<uint8_t>(v & 0x7fu)};
+        for (auto i = n - 1; i > 0; --i) {
+            v >>= 7;
+            out[i - 1] = std::byte{static_cast<uint8_t>(0x80u | (v & 0x7fu))};
+        }
+        return n;
+    }
+
+    namespace detail {
+        [[noreturn]] void throw_invalid_oid(std::string_view reason);
+
+        /**
+         * Checks the first two arcs and combines them into the first subidentifier (X.690 8.19.4).
+         */
+        constexpr uint64_t first_subidentifier(const uint64_t first, const uint64_t second) {
+            if (first > 2) {
+                throw_invalid_oid("the first arc must be 0, 1 or 2");
+            }
+            else if (first < 2 && second >= 40) {
+                throw_invalid_oid("the second arc must be less than 40 under 0 and 1");
+            }
+            else if (second > UINT64_MAX - first * 40) {
+                throw_invalid_oid("the second arc is too large");
+            }
+            return first * 40 + second;
+        }
+    } /* namespace detail */
+
+    /**
+     * The number of contents octets in the encoding of an OBJECT IDENTIFIER.
+     * @param arcs The arcs, at least two of them.  Throws dabers::exception if they aren't a valid OID.
+     */
+    constexpr std::size_t encoded_oid_size(const std::span<const uint64_t> arcs) {
+        if (arcs.size() < 2) {
+            detail::throw_invalid_oid("an OBJECT IDENTIFIER needs at least two arcs");
+        }
+        auto retval = encoded_arc_size(detail::first_subidentifier(arcs[0], arcs[1]));
+        for (auto a : arcs.subspan(2)) {
+            retval += encoded_arc_size(a);
+        }
+        return retval;
+    }
+
+    /**
+     * Writes the contents octets of an OBJECT IDENTIFIER.
+     * @param arcs The arcs, at least two of them.  Throws dabers::exception if they aren't a valid OID.
+     * @param out Where to put the contents octets, which must have room for encoded_oid_size(arcs) bytes.
+     * @return The number of bytes written to out.
+     */
+    constexpr std::size_t encode_oid(const std::span<const uint64_t> arcs, std::byte* const out) {
+        if (arcs.size() < 2) {
+            detail::throw_invalid_oid("an OBJECT IDENTIFIER needs at least two arcs");
+        }
+        auto size = encode_arc(detail::first_subidentifier(arcs[0], arcs[1]), out);
+        for (auto a : arcs.subspan(2)) {
+            size += encode_arc(a, out + size);
+        }
+        return size;
+    }
+
+    /**
+     * Writes a whole OBJECT IDENTIFIER element.
+     * @param t The tag, universal OBJECT IDENTIFIER unless implicitly tagged.
+     */
+    template <typename S>
+        requires byte_sink<std::remove_cvref_t<S>>
+    void write_oid(const std::span<const uint64_t> arcs, S&& output, const tag& t = universal_tags::object_identifier::value) {
+        std::array<std::byte, max_encoded_tag_size + max_encoded_length_size> header{};
+        const auto contents_size = encoded_oid_size(arcs);
+        auto size = encode_tag(t, header.data());
+        size += encode_length(contents_size, header.data() + size);
+        sink_write(output, header.data(), size);
+        std::array<std::byte, max_encoded_arc_size> buf{};
+        sink_write(output, buf.data(), encode_arc(detail::first_subidentifier(arcs[0], arcs[1]), buf.data()));
+        for (auto a : arcs.subspan(2)) {
+            sink_write(output, buf.data(), encode_arc(a, buf.data()));
+        }
+    }
+
+    /**
+     * Decodes the contents octets of an OBJECT IDENTIFIER into its arcs, without throwing
+     * or allocating.  An OID never has more than contents.size() + 1 arcs.
+     * @param contents The contents octets.
+     * @param arcs Where to put the arcs.
+     * @param count The number of arcs written to arcs.
+     * @return decode_error::none on success, decode_error::buffer_too_small if arcs is too
+     * small, or the reason the encoding is invalid.
+     */
+    decode_error try_decode_oid(std::span<const std::byte> contents, std::span<uint64_t> arcs, std::size_t& count) noexcept;
+
+    std::vector<uint64_t> decode_oid(std::span<const std::byte> contents);
+
+    /**
+     * Formats the contents octets of an OBJECT IDENTIFIER in dotted decimal, e.g. "1.2.840.113549".
+     */
+    std::string oid_to_string(std::span<const std::byte> contents);
+
+    /**
+     * The longest encoding an encoded_oid can hold.
+     */
+    constexpr std::size_t max_interned_oid_size = 32;
+
+    /**
+     * The contents octets of a known OBJECT IDENTIFIER, encoded at compile time from its
+     * dotted decimal form.  Checking whether some contents are this OID is a single
+     * comparison of the bytes, without decoding any arcs:
+     *
+     *     constexpr encoded_oid sha256_with_rsa{"1.2.840.113549.1.1.11"};
+     *     if (sha256_with_rsa == node.contents) { ... }
+     */
+    class encoded_oid {
+    public:
+        constexpr encoded_oid() = default;
+
+        /**
+         * Throws dabers::exception (or fails to compile, in a constant expression) if the
+         * string isn't a dotted decimal OID or its encoding is over max_interned_oid_size.
+         */
+        constexpr explicit encoded_oid(const std::string_view dotted) {
+            uint64_t first = 0;
+            std::size_t arc = 0;
+            std::size_t i = 0;
+            while (true) {
+                const auto start = i;
+                uint64_t v = 0;
+                for (; i < dotted.size() && dotted[i] != '.'; ++i) {
+                    const auto c = dotted[i];
+                    if (c < '0' || c > '9') {
+                        detail::throw_invalid_oid("arcs must be decimal numbers");
+                    }
+                    else if (v > (UINT64_MAX - static_cast<uint64_t>(c - '0')) / 10) {
+                        detail::throw_invalid_oid("an arc is too large");
+                    }
+                    v = v * 10 + static_cast<uint64_t>(c - '0');
+                }
+                if (i == start) {
+                    detail::throw_invalid_oid("arcs cannot be empty");
+                }
+                if (arc == 0) {
+                    first = v;
+                }
+                else {
+                    append(arc == 1 ? detail::first_subidentifier(first, v) : v);
+                }
+                ++arc;
+                if (i == dotted.size()) {
+                    break;
+                }
+                ++i;
+            }
+            if (arc < 2) {
+                detail::throw_invalid_oid("an OBJECT IDENTIFIER needs at least two arcs");
+            }
+        }
+
+        [[nodiscard]] constexpr std::span<const std::byte> bytes() const noexcept { return {m_bytes.data(), m_size}; }
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return m_size; }
+
+        friend constexpr bool operator==(const encoded_oid& a, const std::span<const std::byte> b) noexcept {
+            return a.m_size == b.size() && std::equal(b.begin(), b.end(), a.m_bytes.begin());
+        }
+
+        friend constexpr bool operator==(const encoded_oid& a, const encoded_oid& b) noexcept {
+            return a == b.bytes();
+        }
+
+    private:
+        constexpr void append(const uint64_t subidentifier) {
+            if (m_size + encoded_arc_size(subidentifier) > max_interned_oid_size) {
+                detail::throw_invalid_oid("the encoding is too long to intern");
+            }
+            std::array<std::byte, max_encoded_arc_size> buf{};
+            const auto n = encode_arc(subidentifier, buf.data());
+            for (std::size_t i = 0; i < n; ++i) {
+                m_bytes[m_size++] = buf[i];
+            }
+        }
+
+        std::array<std::byte, max_interned_oid_size> m_bytes{};
+        std::size_t m_size = 0;
+    };
+
+    /**
+     * One entry of an oid_registry.
+     */
+    struct oid_entry {
+        std::string_view name;
+        std::string_view dotted;
+        encoded_oid oid;
+
+        constexpr oid_entry(const std::string_view n, const std::string_view d) : name{n}, dotted{d}, oid{d} {}
+    };
+
+    namespace detail {
+
+        constexpr uint64_t oid_mix(uint64_t x) noexcept {
+            x *= 0xff51afd7ed558ccdu;
+            return x ^ (x >> 32);
+        }
+
+        /**
+         * Hashes non-empty contents octets eight at a time, the last eight overlapping the
+         * previous ones when the size isn't a multiple of eight.
+         */
+        constexpr uint64_t oid_hash(const std::span<const std::byte> b) noexcept {
+            auto h = b.size() * 0x9e3779b97f4a7c15u;
+            std::size_t i = 0;
+            for (; b.size() - i > sizeof(uint64_t); i += sizeof(uint64_t)) {
+                h = oid_mix(h ^ load_be_small(b.data() + i, sizeof(uint64_t)));
+            }
+            const auto tail = std::min(b.size(), sizeof(uint64_t));
+            return oid_mix(h ^ load_be_small(b.data() + b.size() - tail, tail));
+        }
+
+    } /* namespace detail */
+
+    /**
+     * A fixed set of OBJECT IDENTIFIERs interned by their contents octets, with a minimal
+     * perfect hash built at compile time (hash and displace:  the top half of the hash
+     * picks a bucket, and each bucket has a displacement chosen so that its members land
+     * in free slots).  Looking up contents costs one hash and one comparison of the bytes,
+     * and never decodes arcs or formats a dotted string.
+     *
+     *     constexpr oid_registry algorithms{{
+     *         {"sha256WithRSAEncryption", "1.2.840.113549.1.1.11"},
+     *         {"ecdsa-with-SHA256", "1.2.840.10045.4.3.2"},
+     *     }};
+     *     if (auto i = algorithms.find(contents); i != algorithms.npos) {
+     *         std::cout << algorithms[i].name;
+     *     }
+     */
+    template <std::size_t N>
+    class oid_registry {
+        static_assert(N > 0 && N < 0xffffu, "An oid_registry needs between 1 and 65534 entries.");
+
+        static constexpr std::size_t SLOTS = std::bit_ceil(N * 2);
+        static constexpr int SLOT_BITS = std::countr_zero(SLOTS);
+        static constexpr std::size_t BUCKETS = (N + 3) / 4;
+        static constexpr uint32_t MAX_DISPLACEMENT = 1u << 16;
+
+        static constexpr std::size_t bucket(const uint64_t h) noexcept {
+            return static_cast<std::size_t>((h >> 32) % BUCKETS);
+        }
+
+        static constexpr std::size_t slot(const uint64_t h, const uint32_t displacement) noexcept {
+            return static_cast<std::size_t>(((h ^ (displacement * 0x9e3779b97f4a7c15u)) * 0xc2b2ae3d27d4eb4fu) >> (64 - SLOT_BITS));
+        }
+
+    public:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /**
+         * Throws dabers::exception (or fails to compile, in a constant expression) if two
+         * entries have the same OID.
+         */
+        constexpr explicit oid_registry(const oid_entry (&entries)[N]) :
+                m_entries{std::to_array(entries)} {
+            std::array<uint64_t, N> hashes{};
+            std::array<uint32_t, BUCKETS> sizes{};
+            for (std::size_t i = 0; i < N; ++i) {
+                for (std::size_t j = 0; j < i; ++j) {
+                    if (m_entries[i].oid == m_entries[j].oid) {
+                        detail::throw_invalid_oid("an oid_registry cannot have the same OID twice");
+                    }
+                }
+                hashes[i] = detail::oid_hash(m_entries[i].oid.bytes());
+                ++sizes[bucket(hashes[i])];
+            }
+
+            //Place the largest buckets first, while most slots are still free.
+            std::array<std::size_t, BUCKETS> order{};
+            for (std::size_t b = 0; b < BUCKETS; ++b) {
+                order[b] = b;
+            }
+            std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b){ return sizes[a] > sizes[b]; });
+
+            for (auto b : order) {
+                if (sizes[b] == 0) {
+                    break;
+                }
+                uint32_t d = 0;
+                while (!try_place(hashes, b, d)) {
+                    if (++d == MAX_DISPLACEMENT) {
+                        detail::throw_invalid_oid("no perfect hash was found for the oid_registry");
+                    }
+                }
+                m_displacements[b] = d;
+            }
+        }
+
+        /**
+         * Finds the entry whose OID has exactly these contents octets.
+         * @return The index of the entry, or npos.
+         */
+        [[nodiscard]] constexpr std::size_t find(const std::span<const std::byte> contents) const noexcept {
+            if (contents.empty() || contents.size() > max_interned_oid_size) {
+                return npos;
+            }
+            const auto h = detail::oid_hash(contents);
+            const auto e = m_slots[slot(h, m_displacements[bucket(h)])];
+            return e != 0 && m_entries[e - 1].oid == contents ? e - 1 : npos;
+        }
+
+        /**
+         * Finds an entry by name, which is a linear search meant for constant expressions.
+         * @return The index of the entry, or npos.
+         */
+        [[nodiscard]] constexpr std::size_t index_of(const std::string_view name) const noexcept {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (m_entries[i].name == name) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return N; }
+        [[nodiscard]] constexpr const oid_entry& operator[](const std::size_t i) const noexcept { return m_entries[i]; }
+        [[nodiscard]] constexpr auto begin() const noexcept { return m_entries.begin(); }
+        [[nodiscard]] constexpr auto end() const noexcept { return m_entries.end(); }
+
+    private:
+        constexpr bool try_place(const std::array<uint64_t, N>& hashes, const std::size_t b, const uint32_t d) {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (bucket(hashes[i]) != b) {
+                    continue;
+                }
+                auto& s = m_slots[slot(hashes[i], d)];
+                if (s != 0) {
+                    //Taken, possibly by an earlier member of this bucket, so undo them.
+                    for (auto& u : m_slots) {
+                        if (u != 0 && bucket(hashes[u - 1]) == b) {
+                            u = 0;
+                        }
+                    }
+                    return false;
+                }
+                s = static_cast<uint16_t>(i + 1);
+            }
+            return true;
+        }
+
+        std::array<oid_entry, N> m_entries;
+        std::array<uint32_t, BUCKETS> m_displacements{};
+        /**
+         * The index of the entry in each slot plus one, 0 for empty slots.
+         */
+        std::array<uint16_t, SLOTS> m_slots{};
+    };
+
+    /**
+     * Common OIDs from X.509 certificates, CMS and SNMP, named as in their RFCs.
+     */
+    inline constexpr oid_registry standard_oids{{
+        {"rsaEncryption", "1.2.840.113549.1.1.1"},
+        {"id-RSAES-OAEP", "1.2.840.113549.1.1.7"},
+        {"id-RSASSA-PSS", "1.2.840.113549.1.1.10"},
+        {"sha1WithRSAEncryption", "1.2.840.113549.1.1.5"},
+        {"sha256WithRSAEncryption", "1.2.840.113549.1.1.11"},
+        {"sha384WithRSAEncryption", "1.2.840.113549.1.1.12"},
+        {"sha512WithRSAEncryption", "1.2.840.113549.1.1.13"},
+        {"id-ecPublicKey", "1.2.840.10045.2.1"},
+        {"prime256v1", "1.2.840.10045.3.1.7"},
+        {"secp384r1", "1.3.132.0.34"},
+        {"secp521r1", "1.3.132.0.35"},
+        {"ecdsa-with-SHA256", "1.2.840.10045.4.3.2"},
+        {"ecdsa-with-SHA384", "1.2.840.10045.4.3.3"},
+        {"ecdsa-with-SHA512", "1.2.840.10045.4.3.4"},
+        {"id-X25519", "1.3.101.110"},
+        {"id-Ed25519", "1.3.101.112"},
+        {"id-sha1", "1.3.14.3.2.26"},
+        {"id-sha256", "2.16.840.1.101.3.4.2.1"},
+        {"id-sha384", "2.16.840.1.101.3.4.2.2"},
+        {"id-sha512", "2.16.840.1.101.3.4.2.3"},
+        {"id-data", "1.2.840.113549.1.7.1"},
+        {"id-signedData", "1.2.840.113549.1.7.2"},
+        {"id-envelopedData", "1.2.840.113549.1.7.3"},
+        {"emailAddress", "1.2.840.113549.1.9.1"},
+        {"id-contentType", "1.2.840.113549.1.9.3"},
+        {"id-messageDigest", "1.2.840.113549.1.9.4"},
+        {"id-signingTime", "1.2.840.113549.1.9.5"},
+        {"id-at-commonName", "2.5.4.3"},
+        {"id-at-surname", "2.5.4.4"},
+        {"id-at-serialNumber", "2.5.4.5"},
+        {"id-at-countryName", "2.5.4.6"},
+        {"id-at-localityName", "2.5.4.7"},
+        {"id-at-stateOrProvinceName", "2.5.4.8"},
+        {"id-at-organizationName", "2.5.4.10"},
+        {"id-at-organizationalUnitName", "2.5.4.11"},
+        {"id-ce-subjectKeyIdentifier", "2.5.29.14"},
+        {"id-ce-keyUsage", "2.5.29.15"},
+        {"id-ce-subjectAltName", "2.5.29.17"},
+        {"id-ce-basicConstraints", "2.5.29.19"},
+        {"id-ce-cRLDistributionPoints", "2.5.29.31"},
+        {"id-ce-certificatePolicies", "2.5.29.32"},
+        {"id-ce-authorityKeyIdentifier", "2.5.29.35"},
+        {"id-ce-extKeyUsage", "2.5.29.37"},
+        {"id-pe-authorityInfoAccess", "1.3.6.1.5.5.7.1.1"},
+        {"id-kp-serverAuth", "1.3.6.1.5.5.7.3.1"},
+        {"id-kp-clientAuth", "1.3.6.1.5.5.7.3.2"},
+        {"id-kp-codeSigning", "1.3.6.1.5.5.7.3.3"},
+        {"id-ad-ocsp", "1.3.6.1.5.5.7.48.1"},
+        {"id-ad-caIssuers", "1.3.6.1.5.5.7.48.2"},
+        {"sysDescr", "1.3.6.1.2.1.1.1"},
+        {"sysObjectID", "1.3.6.1.2.1.1.2"},
+        {"sysUpTime", "1.3.6.1.2.1.1.3"},
+        {"sysName", "1.3.6.1.2.1.1.5"},
+        {"sysUpTime.0", "1.3.6.1.2.1.1.3.0"},
+        {"snmpTrapOID.0", "1.3.6.1.6.3.1.1.4.1.0"},
+    }};
+
+} /* namespace dabers */
+
+#endif //DABERS_OID_H
@@ -0,0 +1,164 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_PARALLEL_H
+#define DABERS_PARALLEL_H
+
+#include "dabers/error.h"
+#include "dabers/rules.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dabers {
+
+    /**
+     * Finds the boundaries of concatenated top-level records.  Only headers are decoded,
+     * except for indefinite length records which have to be walked to find their end.
+     * @param data The concatenated records.
+     * @param r The encoding rules of the records.
+     * @param out The records, appended in order.
+     * @return decode_error::none on success, otherwise the first error found.  The records
+     * before the error are still appended.
+     */
+    decode_error scan_records(std::span<const std::byte> data, rules r, std::vector<std::span<const std::byte>>& out);
+
+    /**
+     * A fixed set of worker threads which share out batches of work.  Each batch is split
+     * evenly between the workers up front, and workers that run out steal half of what's
+     * left from another worker, so uneven record sizes still keep every core busy.  The
+     * thread that starts a batch works on it too.
+     */
+    class thread_pool {
+    public:
+        /**
+         * @param threads The total number of threads working on a batch, including the
+         * caller.  0 means one per hardware thread.
+         */
+        explicit thread_pool(std::size_t threads = 0);
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        ~thread_pool();
+
+        [[nodiscard]] std::size_t size() const noexcept { return m_threads.size() + 1; }
+
+        /**
+         * Calls fn(i) for every i in [0, count) across the pool and waits for all of them.
+         * Only one batch runs at a time.  If any call throws, the rest of the batch is still
+         * run and the first exception is rethrown here.
+         */
+        template <typename F>
+        void for_each_index(std::size_t count, F&& fn) {
+            run(count, [](void* ctx, std::size_t i){ (*static_cast<std::remove_reference_t<F>*>(ctx))(i); },
+                const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+        }
+
+    private:
+        using task_fn = void (*)(void*, std::size_t);
+
+        struct alignas(64) work_range {
+            /**
+             * The next index to do in the low 32 bits and the end in the high 32 bits, so
+             * the owner and thieves can both update it with one compare-and-swap.
+             */
+            std::atomic<uint64_t> bounds{0};
+        };
+
+        void run(std::size_t count, task_fn fn, void* ctx);
+        void work(std::size_t worker) noexcept;
+        void worker_loop(std::size_t worker);
+
+        std::vector<std::thread> m_threads;
+        std::unique_ptr<work_range[]> m_ranges;
+        std::mutex m_batch_mutex;
+        std::mutex m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+        uint64_t m_generation = 0;
+        std::size_t m_base = 0;
+        std::size_t m_active = 0;
+        bool m_stop = false;
+        task_fn m_fn = nullptr;
+        void* m_ctx = nullptr;
+        std::exception_ptr m_error;
+    };
+
+    enum class result_order : uint8_t {
+        /**
+         * Results are delivered in record order, each as soon as it and every record before it are done.
+         */
+        ordered,
+        /**
+         * Results are delivered as soon as they're done.
+         */
+        unordered
+    };
+
+    /**
+     * Decodes records in parallel and delivers the results.  Deliveries never overlap, but
+     * they happen on whichever pool thread finished the work.
+     * @param pool The threads to use.
+     * @param records The records, e.g. from scan_records.
+     * @param decode Called as decode(index, record) on any pool thread; returns the result.
+     * @param deliver Called as deliver(index, result&&).
+     * @param order Whether results have to be delivered in record order.
+     */
+    template <typename Decode, typename Deliver>
+    void parallel_decode(thread_pool& pool, std::span<const std::span<const std::byte>> records,
+                         Decode&& decode, Deliver&& deliver, result_order order = result_order::ordered) {
+        using result_type = std::invoke_result_t<Decode&, std::size_t, std::span<const std::byte>>;
+        std::mutex m;
+        if (order == result_order::unordered) {
+            pool.for_each_index(records.size(), [&](std::size_t i) {
+                auto r = decode(i, records[i]);
+                std::lock_guard lock{m};
+                deliver(i, std::move(r));
+            });
+            return;
+        }
+
+        std::vector<std::optional<result_type>> pending(records.size());
+        std::size_t next = 0;
+        pool.for_each_index(records.size(), [&](std::size_t i) {
+            auto r = decode(i, records[i]);
+            std::lock_guard lock{m};
+            pending[i].emplace(std::move(r));
+            while (next < pending.size() && pending[next]) {
+                deliver(next, std::move(*pending[next]));
+                pending[next].reset();
+                ++next;
+            }
+        });
+    }
+
+    /**
+     * Decodes records in parallel and collects the results in record order.
+     */
+    template <typename Decode>
+    auto parallel_decode(thread_pool& pool, std::span<const std::span<const std::byte>> records, Decode&& decode) {
+        using result_type = std::invoke_result_t<Decode&, std::size_t, std::span<const std::byte>>;
+        std::vector<std::optional<result_type>> results(records.size());
+        pool.for_each_index(records.size(), [&](std::size_t i) { results[i].emplace(decode(i, records[i])); });
+        std::vector<result_type> retval;
+        retval.reserve(results.size());
+        for (auto& r : results) {
+            retval.push_back(std::move(*r));
+        }
+        return retval;
+    }
+
+} /* namespace dabers */
+
+#endif //DABERS_PARALLEL_H
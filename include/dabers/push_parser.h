@@ -0,0 +1,139 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_PUSH_PARSER_H
+#define DABERS_PUSH_PARSER_H
+
+#include "dabers/error.h"
+#include "dabers/header.h"
+#include "dabers/length.h"
+#include "dabers/rules.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dabers {
+
+    /**
+     * Receives the events from a push_parser.
+     *  - on_element is called once an element's identifier and length octets are complete.
+     *    The header's contents span is always empty since the contents may not have arrived.
+     *  - on_content is called with pieces of a primitive element's contents as they arrive.
+     *  - on_end is called when an element is complete, after its contents or children.
+     * depth is 0 for top-level elements.
+     */
+    template <typename H>
+    concept push_handler = requires(H& h, const tlv_header& hdr, std::span<const std::byte> data, std::size_t depth) {
+        h.on_element(hdr, depth);
+        h.on_content(data);
+        h.on_end(depth);
+    };
+
+    /**
+     * The most levels of nesting a push_parser goes into, as max_validate_depth.
+     */
+    constexpr std::size_t max_push_depth = 64;
+
+    struct push_event {
+        enum class kind : uint8_t {
+            need_more,
+            element,
+            content,
+            end
+        };
+
+        kind type = kind::need_more;
+        std::size_t depth = 0;
+        tlv_header header;
+        std::span<const std::byte> content;
+    };
+
+    /**
+     * An incremental decoder which accepts input in arbitrary chunks.  It can stop in the
+     * middle of identifier or length octets (keeping the few bytes it has seen) and in the
+     * middle of contents, and reports each piece of an element as soon as it is available.
+     * Contents are never buffered, so memory use only depends on the nesting depth.
+     */
+    class push_parser {
+    public:
+        explicit push_parser(rules r = rules::ber) noexcept;
+
+        /**
+         * Decodes the next event from the chunk, consuming whatever bytes that takes.
+         * @param chunk The input, which is advanced past the consumed bytes.
+         * @param out The event.  push_event::kind::need_more means the chunk has been used up.
+         * @return decode_error::none, or the error found in the input.  Errors are sticky.
+         */
+        decode_error next(std::span<const std::byte>& chunk, push_event& out) noexcept;
+
+        /**
+         * Decodes a whole chunk, delivering every event to the handler.
+         * @return decode_error::none, or the error found in the input.  Errors are sticky.
+         */
+        template <push_handler H>
+        decode_error feed(std::span<const std::byte> chunk, H& handler) {
+            push_event ev;
+            while (true) {
+                if (auto err = next(chunk, ev); err != decode_error::none) {
+                    return err;
+                }
+                switch (ev.type) {
+                    case push_event::kind::need_more: return decode_error::none;
+                    case push_event::kind::element: handler.on_element(ev.header, ev.depth); break;
+                    case push_event::kind::content: handler.on_content(ev.content); break;
+                    case push_event::kind::end: handler.on_end(ev.depth); break;
+                }
+            }
+        }
+
+        /**
+         * Checks that the input ended between top-level elements.
+         * @return decode_error::none if so, decode_error::buffer_too_small if an element is
+         * incomplete, or the error previously found in the input.
+         */
+        [[nodiscard]] decode_error finish() const noexcept;
+
+        void reset() noexcept;
+
+        [[nodiscard]] std::size_t depth() const noexcept { return m_open.size(); }
+        [[nodiscard]] uint64_t offset() const noexcept { return m_offset; }
+
+    private:
+        static constexpr uint64_t INDEFINITE = ~uint64_t{0};
+        static constexpr std::size_t MAX_HEADER_SIZE = 20;
+
+        decode_error fail(decode_error err) noexcept {
+            m_error = err;
+            return err;
+        }
+
+        struct open_element {
+            /**
+             * The stream offset where the contents end for definite lengths, otherwise where
+             * the nearest enclosing definite length element ends (or INDEFINITE).
+             */
+            uint64_t end;
+            bool indefinite;
+        };
+
+        /**
+         * The length forms allowed for primitive and constructed elements, looked up once for
+         * the rules rather than for every header.
+         */
+        std::array<length_options, 2> m_length_options;
+        decode_error m_error = decode_error::none;
+        bool m_in_content = false;
+        uint64_t m_offset = 0;
+        uint64_t m_content_remaining = 0;
+        std::vector<open_element> m_open;
+        std::array<std::byte, MAX_HEADER_SIZE> m_pending{};
+        std::size_t m_pending_size = 0;
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_PUSH_PARSER_H
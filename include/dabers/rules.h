@@ -5,6 +5,8 @@
 #ifndef DABERS_RULES_H
 #define DABERS_RULES_H
 
+#include <concepts>
+
 namespace dabers {
 
     struct ber{};
@@ -17,6 +19,12 @@ namespace dabers {
         der
     };
 
+    /**
+     * Either one of the rule set tag types, or the runtime rules enum.
+     */
+    template <typename T>
+    concept rule_set = std::same_as<T, ber> || std::same_as<T, cer> || std::same_as<T, der> || std::same_as<T, rules>;
+
 } /* namespace dabers */
 
 #endif //DABERS_RULES_H
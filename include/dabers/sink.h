@@ -0,0 +1,133 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_SINK_H
+#define DABERS_SINK_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <concepts>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dabers {
+
+    /**
+     * Something the encoders can write bytes to, one at a time with put().
+     */
+    template <typename S>
+    concept byte_sink = requires(S& s, std::byte b) {
+        s.put(b);
+    };
+
+    /**
+     * A sink which can also take a whole run of bytes at once, which lets the encoders
+     * write an entire encoded header with a single copy.
+     */
+    template <typename S>
+    concept contiguous_byte_sink = byte_sink<S> && requires(S& s, const std::byte* p, std::size_t n) {
+        s.write(p, n);
+    };
+
+    template <byte_sink S>
+    constexpr void sink_write(S& sink, const std::byte* data, const std::size_t size) {
+        if constexpr (contiguous_byte_sink<S>) {
+            sink.write(data, size);
+        }
+        else {
+            for (std::size_t i = 0; i < size; ++i) {
+                sink.put(data[i]);
+            }
+        }
+    }
+
+    /**
+     * Writes to a caller provided buffer.  There are no bounds checks beyond a debug
+     * assertion, so the caller must make sure the buffer is large enough (for headers
+     * max_encoded_tag_size + max_encoded_length_size is always enough).
+     */
+    class span_sink {
+    public:
+        constexpr span_sink(std::byte* begin, std::byte* end) noexcept : m_cur{begin}, m_end{end} {}
+
+        constexpr void put(std::byte b) noexcept {
+            assert(m_cur != m_end);
+            *m_cur++ = b;
+        }
+
+        void write(const std::byte* data, std::size_t size) noexcept {
+            assert(static_cast<std::size_t>(m_end - m_cur) >= size);
+            std::memcpy(m_cur, data, size);
+            m_cur += size;
+        }
+
+        [[nodiscard]] constexpr std::byte* position() const noexcept { return m_cur; }
+
+    private:
+        std::byte* m_cur;
+        std::byte* m_end;
+    };
+
+    /**
+     * Appends to a vector of bytes.
+     */
+    class vector_sink {
+    public:
+        explicit vector_sink(std::vector<std::byte>& out) noexcept : m_out{&out} {}
+
+        void put(std::byte b) { m_out->push_back(b); }
+        void write(const std::byte* data, std::size_t size) { m_out->insert(m_out->end(), data, data + size); }
+
+    private:
+        std::vector<std::byte>* m_out;
+    };
+
+    /**
+     * Adapts an output iterator.  T is the value type written through the iterator, which
+     * lets iterators over char/uint8_t/etc. be used.  Contiguous iterators to byte sized
+     * values get the bulk write path.
+     */
+    template <typename Iter, typename T = std::byte>
+    class iterator_sink {
+    public:
+        constexpr explicit iterator_sink(Iter it) : m_it{std::move(it)} {}
+
+        constexpr void put(std::byte b) {
+            *m_it = static_cast<T>(b);
+            ++m_it;
+        }
+
+        void write(const std::byte* data, std::size_t size)
+            requires std::contiguous_iterator<Iter> && (sizeof(std::iter_value_t<Iter>) == 1) {
+            std::memcpy(std::to_address(m_it), data, size);
+            m_it += static_cast<std::iter_difference_t<Iter>>(size);
+        }
+
+        [[nodiscard]] constexpr Iter position() const { return m_it; }
+
+    private:
+        Iter m_it;
+    };
+
+    /**
+     * Adapts anything callable with a single byte.  This still makes one call per byte,
+     * but unlike std::function the call can be inlined.
+     */
+    template <typename F>
+    class function_sink {
+    public:
+        constexpr explicit function_sink(F& f) noexcept : m_f{&f} {}
+
+        constexpr void put(std::byte b) { (*m_f)(b); }
+
+    private:
+        F* m_f;
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_SINK_H
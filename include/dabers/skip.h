@@ -0,0 +1,46 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_SKIP_H
+#define DABERS_SKIP_H
+
+#include "dabers/error.h"
+#include "dabers/rules.h"
+
+#include <cstddef>
+
+namespace dabers {
+
+    /**
+     * Moves past a whole element without decoding anything inside it.  Definite length
+     * elements are skipped in constant time using their length.  Indefinite length elements
+     * have to be walked to find their end-of-contents octets, but only nested indefinite
+     * length elements are entered; everything with a definite length inside them is jumped
+     * over the same way.
+     * @param r The rules which determine which length forms are allowed.
+     * @param begin The start of the element.  On success it is moved past the element
+     * (including any end-of-contents octets), on failure it is left untouched.
+     * @param end The end of the buffer.
+     * @return decode_error::none on success, otherwise the first problem found.
+     */
+    decode_error skip_element(rules r, const std::byte*& begin, const std::byte* end) noexcept;
+    decode_error skip_element(ber, const std::byte*& begin, const std::byte* end) noexcept;
+    decode_error skip_element(cer, const std::byte*& begin, const std::byte* end) noexcept;
+    decode_error skip_element(der, const std::byte*& begin, const std::byte* end) noexcept;
+
+    /**
+     * Finds the end-of-contents octets which end an indefinite length element.
+     * @param r The rules which determine which length forms are allowed.
+     * @param contents The start of the element's contents, i.e. just past its header.
+     * @param end The end of the buffer.
+     * @param eoc Set to the end-of-contents octets on success.
+     * @return decode_error::none on success, otherwise the first problem found.
+     */
+    decode_error find_end_of_contents(rules r, const std::byte* contents, const std::byte* end, const std::byte*& eoc) noexcept;
+    decode_error find_end_of_contents(ber, const std::byte* contents, const std::byte* end, const std::byte*& eoc) noexcept;
+    decode_error find_end_of_contents(cer, const std::byte* contents, const std::byte* end, const std::byte*& eoc) noexcept;
+
+} /* namespace dabers */
+
+#endif //DABERS_SKIP_H
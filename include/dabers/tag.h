@@ -5,11 +5,19 @@
 #ifndef DABERS_TAG_H
 #define DABERS_TAG_H
 
+#include "dabers/error.h"
+#include "dabers/sink.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <concepts>
 #include <compare>
 #include <ostream>
+#include <span>
 
 namespace dabers {
 
@@ -33,8 +41,147 @@ namespace dabers {
     bool operator==(const tag& a, const tag& b) noexcept;
     std::ostream& operator<<(std::ostream& os, const tag& t);
 
+    namespace detail {
+
+        /**
+         * Everything the first identifier octet says about a tag, packed into four bytes so
+         * a lookup is a single load.
+         */
+        struct identifier_octet {
+            tag_class_type tag_class;
+            bool constructed;
+            uint8_t tag_number;
+            bool long_form;
+        };
+        static_assert(sizeof(identifier_octet) == 4);
+
+        /**
+         * The decoded form of every possible first identifier octet.  Almost all tags in real
+         * data have numbers below 31, so this is the whole of the decode for them and the
+         * long form loop only runs on the 0x1f escape.
+         */
+        inline constexpr std::array<identifier_octet, 256> identifier_octet_table = []{
+            std::array<identifier_octet, 256> retval{};
+            for (unsigned int i = 0; i < retval.size(); ++i) {
+                const auto number = static_cast<uint8_t>(i & 0x1fu);
+                retval[i] = {static_cast<tag_class_type>(i & 0xc0u), (i & 0x20u) != 0, number, number == 0x1fu};
+            }
+            return retval;
+        }();
+
+        /**
+         * The rest of try_parse_tag, for the 0x1f escape and for empty or null buffers.
+         */
+        decode_error try_parse_long_form_tag(const std::byte*& begin, const std::byte* end, tag& out) noexcept;
+
+    } /* namespace detail */
+
+    /**
+     * Parses a tag without throwing.  On success begin is moved past the identifier
+     * octets, on failure it is left untouched and out is unspecified.
+     * @param begin The start of the buffer.
+     * @param end The end of the buffer.
+     * @param out The parsed tag.
+     * @return decode_error::none on success, otherwise the reason the tag could not be parsed.
+     */
+    inline decode_error try_parse_tag(const std::byte*& begin, const std::byte* const end, tag& out) noexcept {
+        //begin < end also rules out a null end, leaving the errors for bad buffers to the long form.
+        if (begin != nullptr && begin < end) [[likely]] {
+            const auto& first = detail::identifier_octet_table[std::to_integer<uint8_t>(*begin)];
+            if (!first.long_form) [[likely]] {
+                out.tag_class = first.tag_class;
+                out.constructed = first.constructed;
+                out.tag_number = first.tag_number;
+                ++begin;
+                return decode_error::none;
+            }
+        }
+        return detail::try_parse_long_form_tag(begin, end, out);
+    }
+
     tag parse_tag(const std::byte*& begin, const std::byte* end);
 
+    /**
+     * The largest tag number which fits in a packed tag.
+     */
+    constexpr uint64_t max_packed_tag_number = (uint64_t{1} << 61) - 1;
+
+    /**
+     * Packs a tag into a single integer, with the class in the top two bits, then the tag
+     * number, then the constructed bit.  Packed tags compare the same way tags do.  The tag
+     * number must be no more than max_packed_tag_number.
+     */
+    constexpr uint64_t pack_tag(const tag& t) noexcept {
+        return (static_cast<uint64_t>(t.tag_class) << 56) | (t.tag_number << 1) | static_cast<uint64_t>(t.constructed);
+    }
+
+    constexpr tag unpack_tag(const uint64_t packed) noexcept {
+        return {static_cast<tag_class_type>(packed >> 56 & 0xc0u), (packed & 1u) != 0, packed >> 1 & max_packed_tag_number};
+    }
+
+    /**
+     * The most octets a tag can take when encoded:  the identifier octet plus up to ten
+     * octets of seven bits each for a 64-bit tag number.
+     */
+    constexpr std::size_t max_encoded_tag_size = 11;
+
+    /**
+     * The number of octets encode_tag/write_tag produce for a tag with the given number.
+     */
+    constexpr std::size_t encoded_tag_size(uint64_t tag_number) noexcept {
+        return tag_number <= 30 ? 1 : 1 + static_cast<std::size_t>((std::bit_width(tag_number) + 6) / 7);
+    }
+
+    constexpr std::size_t encoded_tag_size(const tag& t) noexcept {
+        return encoded_tag_size(t.tag_number);
+    }
+
+    /**
+     * Encodes a tag in a way which is compatible with BER, CER, and DER formats.
+     * @param t The tag to encode.
+     * @param out Where to put the encoded tag, which must have room for max_encoded_tag_size bytes.
+     * @return The number of bytes written to out.
+     */
+    constexpr std::size_t encode_tag(const tag& t, std::byte* out) noexcept {
+        auto first = std::byte{static_cast<uint8_t>(t.tag_class)};
+        first |= t.constructed ? std::byte{0x20u} : std::byte{0};
+        if (t.tag_number > 30) {
+            constexpr int NSIZE = 7;
+            out[0] = first | std::byte{0x1fu};
+            const auto groups = static_cast<std::size_t>((std::bit_width(t.tag_number) + NSIZE - 1) / NSIZE);
+            auto num = t.tag_number;
+            out[groups] = std::byte{static_cast<uint8_t>(num & 0x7fu)};
+            for (std::size_t i = groups - 1; i > 0; --i) {
+                num >>= NSIZE;
+                out[i] = std::byte{static_cast<uint8_t>(0x80u | (num & 0x7fu))};
+            }
+            return groups + 1;
+        }
+        else {
+            out[0] = first | std::byte{static_cast<uint8_t>(t.tag_number)};
+            return 1;
+        }
+    }
+
+    /**
+     * This writes a tag in a way which is compatible with BER, CER, and DER formats
+     * so that we don't need separate functions for each.
+     * @param t The tag to write.
+     * @param output The sink to write to.  Contiguous sinks get the whole tag in a single write.
+     */
+    template <typename S>
+        requires byte_sink<std::remove_cvref_t<S>>
+    void write_tag(const tag& t, S&& output) {
+        if (t.tag_number <= 30) {
+            auto first = std::byte{static_cast<uint8_t>(static_cast<uint8_t>(t.tag_class) | t.tag_number)};
+            output.put(t.constructed ? first | std::byte{0x20u} : first);
+        }
+        else {
+            std::array<std::byte, max_encoded_tag_size> buf{};
+            sink_write(output, buf.data(), encode_tag(t, buf.data()));
+        }
+    }
+
     /**
      * This writes a tag in a way which is compatible with BER, CER, and DER formats
      * so that we don't need separate functions for each.
@@ -43,16 +190,91 @@ namespace dabers {
      */
     void write_tag(const tag& t, const std::function<void(std::byte)>& output);
 
+    template <std::invocable<std::byte> F>
+    void write_tag(const tag& t, F&& output) {
+        write_tag(t, function_sink<std::remove_reference_t<F>>{output});
+    }
+
     template <std::output_iterator<std::byte> Iter>
     void write_tag(const tag& t, Iter output) {
-        write_tag(t, [&output](std::byte b){ *output = b; ++output; });
+        write_tag(t, iterator_sink<Iter>{std::move(output)});
     }
 
     template <std::integral T, std::output_iterator<T> Iter>
     void write_tag(const tag& t, Iter output) {
-        write_tag(t, [&output](std::byte b){ *output = static_cast<T>(b); ++output; });
+        write_tag(t, iterator_sink<Iter, T>{std::move(output)});
     }
 
+    /**
+     * Encodes a tag known at compile time.
+     * @tparam T The tag to encode.
+     * @return The identifier octets.
+     */
+    template <tag T>
+    consteval std::array<std::byte, encoded_tag_size(T)> encode_tag() noexcept {
+        std::array<std::byte, max_encoded_tag_size> buf{};
+        encode_tag(T, buf.data());
+        std::array<std::byte, encoded_tag_size(T)> retval{};
+        for (std::size_t i = 0; i < retval.size(); ++i) {
+            retval[i] = buf[i];
+        }
+        return retval;
+    }
+
+    /**
+     * A tag known at compile time, along with its encoding, so it can be written as a
+     * constant and matched against input with a single fixed-size compare.
+     */
+    template <tag_class_type Class, bool Constructed, uint64_t Number>
+    struct static_tag {
+        static constexpr tag value{Class, Constructed, Number};
+        static constexpr std::array<std::byte, encoded_tag_size(Number)> bytes = encode_tag<value>();
+        static constexpr std::size_t size = bytes.size();
+
+        /**
+         * Checks whether the input starts with this tag.  At least size bytes must be readable.
+         */
+        static bool matches(const std::byte* input) noexcept {
+            return std::memcmp(input, bytes.data(), size) == 0;
+        }
+
+        static bool matches(std::span<const std::byte> input) noexcept {
+            return input.size() >= size && matches(input.data());
+        }
+
+        template <typename S>
+            requires byte_sink<std::remove_cvref_t<S>>
+        static void write(S&& output) {
+            if constexpr (size == 1) {
+                output.put(bytes[0]);
+            }
+            else {
+                sink_write(output, bytes.data(), size);
+            }
+        }
+    };
+
+    namespace universal_tags {
+        using boolean = static_tag<tag_class_type::universal, false, 1>;
+        using integer = static_tag<tag_class_type::universal, false, 2>;
+        using bit_string = static_tag<tag_class_type::universal, false, 3>;
+        using octet_string = static_tag<tag_class_type::universal, false, 4>;
+        using null = static_tag<tag_class_type::universal, false, 5>;
+        using object_identifier = static_tag<tag_class_type::universal, false, 6>;
+        using enumerated = static_tag<tag_class_type::universal, false, 10>;
+        using utf8_string = static_tag<tag_class_type::universal, false, 12>;
+        using sequence = static_tag<tag_class_type::universal, true, 16>;
+        using set = static_tag<tag_class_type::universal, true, 17>;
+        using numeric_string = static_tag<tag_class_type::universal, false, 18>;
+        using printable_string = static_tag<tag_class_type::universal, false, 19>;
+        using ia5_string = static_tag<tag_class_type::universal, false, 22>;
+        using utc_time = static_tag<tag_class_type::universal, false, 23>;
+        using generalized_time = static_tag<tag_class_type::universal, false, 24>;
+        using visible_string = static_tag<tag_class_type::universal, false, 26>;
+        using universal_string = static_tag<tag_class_type::universal, false, 28>;
+        using bmp_string = static_tag<tag_class_type::universal, false, 30>;
+    } /* namespace universal_tags */
+
 } /* namespace dabers */
 
 #endif //DABERS_TAG_H
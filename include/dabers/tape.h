@@ -0,0 +1,112 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_TAPE_H
+#define DABERS_TAPE_H
+
+#include "dabers/error.h"
+#include "dabers/rules.h"
+#include "dabers/tag.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dabers {
+
+    /**
+     * One element of a document, as recorded on a tape.
+     */
+    struct tape_entry {
+        /**
+         * The offset of the element's first identifier octet from the start of the document.
+         */
+        uint64_t offset = 0;
+        /**
+         * The exact length of the contents, even for indefinite length elements.
+         */
+        uint64_t content_length = 0;
+        /**
+         * The tag, as packed by pack_tag.
+         */
+        uint64_t packed_tag = 0;
+        uint32_t parent = 0;
+        uint32_t next_sibling = 0;
+        uint8_t header_size = 0;
+        bool indefinite = false;
+    };
+
+    /**
+     * A flat index of every element in a BER/CER/DER document, built in a single pass.
+     * Entries are in document order, so an element's first child (if it has any) is the
+     * entry right after it, and every other relationship is an index stored in the entry.
+     * Once built a tape is read-only and can be shared between any number of readers.  The
+     * document must outlive the tape.
+     */
+    class tape {
+    public:
+        static constexpr uint32_t npos = 0xffffffffu;
+
+        tape() = default;
+
+        /**
+         * Indexes a document, replacing anything previously indexed.  Storage is reused
+         * between builds, so rebuilding a tape for similar documents doesn't allocate.
+         * @param document The document, which may have several top-level elements.
+         * @param r The encoding rules of the document.
+         * @return decode_error::none on success, otherwise the first error found, in which case the tape is empty.
+         */
+        decode_error build(std::span<const std::byte> document, rules r = rules::ber);
+
+        [[nodiscard]] std::span<const std::byte> document() const noexcept { return m_document; }
+        [[nodiscard]] std::span<const tape_entry> entries() const noexcept { return m_entries; }
+        [[nodiscard]] std::size_t size() const noexcept { return m_entries.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_entries.empty(); }
+        [[nodiscard]] const tape_entry& operator[](uint32_t i) const noexcept { return m_entries[i]; }
+
+        [[nodiscard]] tag id(uint32_t i) const noexcept { return unpack_tag(m_entries[i].packed_tag); }
+        [[nodiscard]] uint32_t parent(uint32_t i) const noexcept { return m_entries[i].parent; }
+        [[nodiscard]] uint32_t next_sibling(uint32_t i) const noexcept { return m_entries[i].next_sibling; }
+        [[nodiscard]] uint32_t first_child(uint32_t i) const noexcept {
+            return i + 1 < m_entries.size() && m_entries[i + 1].parent == i ? i + 1 : npos;
+        }
+
+        [[nodiscard]] std::span<const std::byte> contents(uint32_t i) const noexcept {
+            const auto& e = m_entries[i];
+            return m_document.subspan(static_cast<std::size_t>(e.offset + e.header_size), static_cast<std::size_t>(e.content_length));
+        }
+
+        /**
+         * The whole element:  the header, contents and, for the indefinite form, the end-of-contents octets.
+         */
+        [[nodiscard]] std::span<const std::byte> encoded(uint32_t i) const noexcept {
+            const auto& e = m_entries[i];
+            return m_document.subspan(static_cast<std::size_t>(e.offset),
+                                      static_cast<std::size_t>(e.header_size + e.content_length + (e.indefinite ? 2 : 0)));
+        }
+
+    private:
+        struct open_element {
+            uint32_t index;
+            uint32_t last_child;
+            /**
+             * The end of the contents for definite lengths, otherwise the end of the nearest
+             * enclosing definite length element (or the document).
+             */
+            const std::byte* end;
+            bool indefinite;
+        };
+
+        template <typename Codec>
+        decode_error build_with(std::span<const std::byte> document);
+
+        std::span<const std::byte> m_document;
+        std::vector<tape_entry> m_entries;
+        std::vector<open_element> m_open;
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_TAPE_H
@@ -0,0 +1,192 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_TIME_H
+#define DABERS_TIME_H
+
+#include "dabers/error.h"
+#include "dabers/length.h"
+#include "dabers/rules.h"
+#include "dabers/sink.h"
+#include "dabers/tag.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace dabers {
+
+    /**
+     * The time points the UTCTime and GeneralizedTime functions work with.  Microseconds
+     * cover all of GeneralizedTime's years 0000 to 9999, which nanoseconds don't.
+     */
+    using asn1_time = std::chrono::sys_time<std::chrono::microseconds>;
+
+    /**
+     * The most contents octets the encoders write:  YYYYMMDDhhmmss.ffffffZ
+     */
+    constexpr std::size_t max_encoded_time_size = 22;
+
+    namespace detail {
+
+        /**
+         * Reads 8 characters as a little-endian integer, so the first is the lowest byte.
+         */
+        constexpr uint64_t load_chars(const std::byte* const p) noexcept {
+            uint64_t v = 0;
+            for (int i = 7; i >= 0; --i) {
+                v = (v << 8) | std::to_integer<uint64_t>(p[i]);
+            }
+            return v;
+        }
+
+        /**
+         * Whether all 8 characters in v are digits:  their high nibbles are all 3, and
+         * still are after adding 6, which pushes ':' and up over.
+         */
+        constexpr bool all_digits(const uint64_t v) noexcept {
+            constexpr uint64_t HIGH_NIBBLES = 0xf0f0f0f0f0f0f0f0u;
+            return (v & HIGH_NIBBLES) == 0x3030303030303030u && ((v + 0x0606060606060606u) & HIGH_NIBBLES) == 0x3030303030303030u;
+        }
+
+        /**
+         * The values of the 4 pairs of digits in v, from load_chars, in the low byte of each
+         * 16 bit lane.  Each digit times 10 plus the digit after it is at most 99, so nothing
+         * carries between lanes.
+         */
+        constexpr uint64_t digit_pairs(const uint64_t v) noexcept {
+            const auto d = v - 0x3030303030303030u;
+            return (d * 10 + (d >> 8)) & 0x00ff00ff00ff00ffu;
+        }
+
+        constexpr int digit_pair(const uint64_t pairs, const int i) noexcept {
+            return static_cast<int>((pairs >> (i * 16)) & 0xffu);
+        }
+
+        /**
+         * Checks the fields of a time and converts it.  Leap seconds can't be put on a system
+         * clock, so :60 is out of range too.
+         */
+        constexpr decode_error to_time(const int y, const int mon, const int d, const int h, const int min, const int s, asn1_time& out) noexcept {
+            const std::chrono::year_month_day ymd{std::chrono::year{y}, std::chrono::month{static_cast<unsigned int>(mon)}, std::chrono::day{static_cast<unsigned int>(d)}};
+            //Every month has 28 days, so the calendar only needs looking at past that.
+            if (mon < 1 || mon > 12 || d < 1 || (d > 28 && !ymd.ok()) || h > 23 || min > 59 || s > 59) {
+                return decode_error::invalid_time;
+            }
+            out = asn1_time{std::chrono::sys_days{ymd}} + std::chrono::seconds{(h * 60 + min) * 60 + s};
+            return decode_error::none;
+        }
+
+        constexpr int utc_year(const int yy) noexcept {
+            return yy < 50 ? 2000 + yy : 1900 + yy;
+        }
+
+        /**
+         * The forms which aren't the fixed one.
+         */
+        decode_error decode_utc_time_general(std::span<const std::byte> contents, asn1_time& out, rules r) noexcept;
+        decode_error decode_generalized_time_general(std::span<const std::byte> contents, asn1_time& out, rules r) noexcept;
+
+    } /* namespace detail */
+
+    /**
+     * Decodes the contents octets of a UTCTime.  YYMMDDhhmmssZ, which is the only form DER
+     * and CER allow and nearly the only one seen, is converted without a loop;  under BER
+     * the seconds may be left out and the time may have a +hhmm or -hhmm offset instead of Z.
+     * Two digit years under 50 are 20YY and the rest 19YY, as in RFC 5280.
+     * @param contents The contents octets.
+     * @param out The time.
+     * @param r The rules the encoding must follow.
+     * @return decode_error::none on success, decode_error::invalid_time if the contents
+     * aren't a time, or decode_error::non_canonical_time for a form DER and CER forbid.
+     */
+    constexpr decode_error try_decode_utc_time(const std::span<const std::byte> contents, asn1_time& out, const rules r = rules::ber) noexcept {
+        if (contents.size() == 13 && contents[12] == std::byte{'Z'}) {
+            //YYMMDDhhmmssZ:  YYMMDDhh and DDhhmmss, overlapping.
+            const auto a = detail::load_chars(contents.data());
+            const auto b = detail::load_chars(contents.data() + 4);
+            if (detail::all_digits(a) && detail::all_digits(b)) {
+                const auto pa = detail::digit_pairs(a);
+                const auto pb = detail::digit_pairs(b);
+                return detail::to_time(detail::utc_year(detail::digit_pair(pa, 0)), detail::digit_pair(pa, 1), detail::digit_pair(pa, 2),
+                                       detail::digit_pair(pb, 1), detail::digit_pair(pb, 2), detail::digit_pair(pb, 3), out);
+            }
+        }
+        return detail::decode_utc_time_general(contents, out, r);
+    }
+
+    /**
+     * Decodes the contents octets of a GeneralizedTime.  YYYYMMDDhhmmssZ is converted
+     * without a loop;  other forms, with fractions (of the hour, minute or second, with '.'
+     * or ','), without minutes or seconds, or with an offset, take a general path.  Digits
+     * of a fraction past the microsecond are dropped.  Local times, without Z or an offset,
+     * can't be placed on the UTC time line and are decode_error::invalid_time, as are leap
+     * seconds, which a system clock has no room for.
+     * @return As for try_decode_utc_time.  DER and CER also require the fraction to use '.'
+     * and have no trailing zeros.
+     */
+    constexpr decode_error try_decode_generalized_time(const std::span<const std::byte> contents, asn1_time& out, const rules r = rules::ber) noexcept {
+        if (contents.size() == 15 && contents[14] == std::byte{'Z'}) {
+            //YYYYMMDDhhmmssZ:  YYYYMMDD and DDhhmmss, overlapping.
+            const auto a = detail::load_chars(contents.data());
+            const auto b = detail::load_chars(contents.data() + 6);
+            if (detail::all_digits(a) && detail::all_digits(b)) {
+                const auto pa = detail::digit_pairs(a);
+                const auto pb = detail::digit_pairs(b);
+                return detail::to_time(detail::digit_pair(pa, 0) * 100 + detail::digit_pair(pa, 1), detail::digit_pair(pa, 2), detail::digit_pair(pa, 3),
+                                       detail::digit_pair(pb, 1), detail::digit_pair(pb, 2), detail::digit_pair(pb, 3), out);
+            }
+        }
+        return detail::decode_generalized_time_general(contents, out, r);
+    }
+
+    asn1_time decode_utc_time(std::span<const std::byte> contents, rules r = rules::ber);
+    asn1_time decode_generalized_time(std::span<const std::byte> contents, rules r = rules::ber);
+
+    /**
+     * Writes the contents octets of a UTCTime in the DER form, YYMMDDhhmmssZ.  Anything
+     * under a second is dropped.  Throws dabers::exception if the year isn't from 1950 to 2049.
+     * @param out Where to put it, which must have room for max_encoded_time_size bytes.
+     * @return The number of bytes written to out.
+     */
+    std::size_t encode_utc_time(asn1_time t, std::byte* out);
+
+    /**
+     * Writes the contents octets of a GeneralizedTime in the DER form, with a fraction of
+     * a second only when there is one and without trailing zeros.  Throws dabers::exception
+     * if the year isn't from 0 to 9999.
+     */
+    std::size_t encode_generalized_time(asn1_time t, std::byte* out);
+
+    /**
+     * Writes a complete UTCTime TLV to a sink.
+     */
+    template <typename S>
+        requires byte_sink<std::remove_cvref_t<S>>
+    void write_utc_time(const asn1_time t, S&& output, const tag& tg = universal_tags::utc_time::value) {
+        std::array<std::byte, max_encoded_tag_size + max_encoded_length_size + max_encoded_time_size> buf{};
+        const auto size = encode_tag(tg, buf.data());
+        const auto header_size = size + 1;
+        //The contents are always short, so the length is always one octet.
+        const auto len = encode_utc_time(t, buf.data() + header_size);
+        buf[size] = std::byte{static_cast<uint8_t>(len)};
+        sink_write(output, buf.data(), header_size + len);
+    }
+
+    template <typename S>
+        requires byte_sink<std::remove_cvref_t<S>>
+    void write_generalized_time(const asn1_time t, S&& output, const tag& tg = universal_tags::generalized_time::value) {
+        std::array<std::byte, max_encoded_tag_size + max_encoded_length_size + max_encoded_time_size> buf{};
+        const auto size = encode_tag(tg, buf.data());
+        const auto header_size = size + 1;
+        const auto len = encode_generalized_time(t, buf.data() + header_size);
+        buf[size] = std::byte{static_cast<uint8_t>(len)};
+        sink_write(output, buf.data(), header_size + len);
+    }
+
+} /* namespace dabers */
+
+#endif //DABERS_TIME_H
@@ -0,0 +1,176 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_TLV_VIEW_H
+#define DABERS_TLV_VIEW_H
+
+#include "dabers/error.h"
+#include "dabers/header.h"
+#include "dabers/rules.h"
+#include "dabers/tag.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+
+namespace dabers {
+
+    class tlv_view;
+
+    /**
+     * A single element found by a tlv_cursor or tlv_view.  Unlike a plain tlv_header, the
+     * contents of an indefinite length element are exact (they stop before the end-of-contents
+     * octets) since the cursor has to find the end of the element anyway to get past it.
+     */
+    class tlv_element {
+    public:
+        tlv_element() = default;
+        tlv_element(const tlv_header& h, std::span<const std::byte> encoded, rules r) noexcept :
+                m_header{h}, m_encoded{encoded}, m_rules{r} {}
+
+        [[nodiscard]] const tag& id() const noexcept { return m_header.id; }
+        [[nodiscard]] bool constructed() const noexcept { return m_header.id.constructed; }
+        [[nodiscard]] bool indefinite() const noexcept { return m_header.indefinite(); }
+        [[nodiscard]] std::size_t header_size() const noexcept { return m_header.header_size; }
+        [[nodiscard]] std::span<const std::byte> contents() const noexcept { return m_header.contents; }
+        [[nodiscard]] const tlv_header& header() const noexcept { return m_header; }
+
+        /**
+         * The whole element:  the header, contents and, for the indefinite form, the end-of-contents octets.
+         */
+        [[nodiscard]] std::span<const std::byte> encoded() const noexcept { return m_encoded; }
+
+        /**
+         * A view over the elements inside this one.  Nothing is parsed until the view is iterated.
+         * Primitive elements have no children, so this is an empty view for them.
+         */
+        [[nodiscard]] tlv_view children() const noexcept;
+
+        /**
+         * The contents of a character string element as UTF-8, transcoding a BMPString or
+         * UniversalString.  max_utf8_size(id(), contents().size()) is always enough room.
+         * @return As for try_string_to_utf8.
+         */
+        decode_error try_to_utf8(std::span<char> out, std::size_t& written) const noexcept;
+
+        std::string to_utf8() const;
+
+    private:
+        tlv_header m_header;
+        std::span<const std::byte> m_encoded;
+        rules m_rules = rules::ber;
+    };
+
+    /**
+     * Walks sibling elements in a buffer one at a time without throwing.  Nothing is
+     * copied or allocated; the cursor is just a position in the buffer.
+     */
+    class tlv_cursor {
+    public:
+        tlv_cursor() = default;
+        explicit tlv_cursor(std::span<const std::byte> buffer, rules r = rules::ber) noexcept :
+                m_cur{buffer.data()}, m_end{buffer.data() + buffer.size()}, m_rules{r}, m_next{next_for(r)} {}
+
+        /**
+         * Reads the next element and moves past it, including the contents and any
+         * end-of-contents octets.  On failure the cursor doesn't move.
+         * @param out The element that was read.
+         * @return decode_error::none on success, otherwise the reason the element could not be read.
+         */
+        decode_error next(tlv_element& out) noexcept { return m_next(*this, out); }
+
+        [[nodiscard]] bool done() const noexcept { return m_cur == m_end; }
+        [[nodiscard]] rules get_rules() const noexcept { return m_rules; }
+        [[nodiscard]] std::span<const std::byte> remaining() const noexcept {
+            return {m_cur, static_cast<std::size_t>(m_end - m_cur)};
+        }
+
+    private:
+        using next_fn = decode_error (*)(tlv_cursor&, tlv_element&) noexcept;
+
+        /**
+         * next for one rule set, picked when the cursor is made so stepping through the
+         * elements doesn't go back through the runtime rules.
+         */
+        template <typename Rules>
+        static decode_error next_as(tlv_cursor& c, tlv_element& out) noexcept;
+
+        static next_fn next_for(rules r) noexcept;
+
+        const std::byte* m_cur = nullptr;
+        const std::byte* m_end = nullptr;
+        rules m_rules = rules::ber;
+        next_fn m_next = &next_as<ber>;
+    };
+
+    /**
+     * A lazy forward range over the sibling elements in a buffer.  Malformed input is
+     * reported by throwing when the iterator reaches it; use tlv_cursor to avoid exceptions.
+     */
+    class tlv_view {
+    public:
+        class iterator {
+        public:
+            using value_type = tlv_element;
+            using difference_type = std::ptrdiff_t;
+            using reference = const tlv_element&;
+            using pointer = const tlv_element*;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+            explicit iterator(tlv_cursor c) : m_cursor{c} { ++*this; }
+
+            reference operator*() const noexcept { return m_current; }
+            pointer operator->() const noexcept { return &m_current; }
+
+            iterator& operator++();
+            iterator operator++(int) {
+                auto retval = *this;
+                ++*this;
+                return retval;
+            }
+
+            friend bool operator==(const iterator& a, const iterator& b) noexcept {
+                return a.m_at_end == b.m_at_end && a.m_current.encoded().data() == b.m_current.encoded().data();
+            }
+
+            friend bool operator==(const iterator& a, std::default_sentinel_t) noexcept {
+                return a.m_at_end;
+            }
+
+        private:
+            tlv_cursor m_cursor;
+            tlv_element m_current;
+            bool m_at_end = true;
+        };
+
+        tlv_view() = default;
+        explicit tlv_view(std::span<const std::byte> buffer, rules r = rules::ber) noexcept :
+                m_buffer{buffer}, m_rules{r} {}
+
+        [[nodiscard]] iterator begin() const { return iterator{tlv_cursor{m_buffer, m_rules}}; }
+        [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+        [[nodiscard]] bool empty() const noexcept { return m_buffer.empty(); }
+        [[nodiscard]] std::span<const std::byte> buffer() const noexcept { return m_buffer; }
+        [[nodiscard]] tlv_cursor cursor() const noexcept { return tlv_cursor{m_buffer, m_rules}; }
+
+    private:
+        std::span<const std::byte> m_buffer;
+        rules m_rules = rules::ber;
+    };
+
+    inline tlv_view tlv_element::children() const noexcept {
+        return constructed() ? tlv_view{contents(), m_rules} : tlv_view{{}, m_rules};
+    }
+
+} /* namespace dabers */
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<dabers::tlv_view> = true;
+
+#endif //DABERS_TLV_VIEW_H
@@ -0,0 +1,175 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_TREE_H
+#define DABERS_TREE_H
+
+#include "dabers/error.h"
+#include "dabers/rules.h"
+#include "dabers/tag.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace dabers {
+
+    /**
+     * One decoded element.  Relationships are indices into the arena the node lives in.
+     */
+    struct tree_node {
+        static constexpr uint32_t npos = 0xffffffffu;
+
+        tag id;
+        /**
+         * The exact contents, even for indefinite length elements.  This points into the
+         * decoded input, which must outlive the node.
+         */
+        std::span<const std::byte> contents;
+        uint32_t parent = npos;
+        uint32_t first_child = npos;
+        uint32_t next_sibling = npos;
+        uint8_t header_size = 0;
+        bool indefinite = false;
+
+        /**
+         * The contents of a character string node as UTF-8, as for tlv_element::try_to_utf8.
+         */
+        decode_error try_to_utf8(std::span<char> out, std::size_t& written) const noexcept;
+
+        std::string to_utf8() const;
+    };
+
+    /**
+     * Contiguous storage for the nodes of any number of trees.  Resetting the arena drops
+     * every node (and invalidates every tree decoded into it) but keeps the storage, so
+     * once it has grown to fit the largest message, decoding doesn't allocate at all.
+     */
+    class node_arena {
+    public:
+        node_arena() = default;
+        explicit node_arena(std::size_t initial_capacity) {
+            m_nodes.reserve(initial_capacity);
+        }
+
+        void reset() noexcept {
+            m_nodes.clear();
+            m_open.clear();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return m_nodes.size(); }
+        [[nodiscard]] std::size_t capacity() const noexcept { return m_nodes.capacity(); }
+        [[nodiscard]] const tree_node& operator[](uint32_t i) const noexcept { return m_nodes[i]; }
+
+    private:
+        friend class tree;
+
+        struct open_node {
+            uint32_t index;
+            uint32_t last_child;
+            const std::byte* end;
+            bool indefinite;
+        };
+
+        std::vector<tree_node> m_nodes;
+        std::vector<open_node> m_open;
+    };
+
+    /**
+     * A decoded document whose nodes live in a node_arena.  Trees are cheap handles, they
+     * don't own anything.
+     */
+    class tree {
+    public:
+        /**
+         * Iterates a node and its following siblings.
+         */
+        class sibling_iterator {
+        public:
+            using value_type = tree_node;
+            using difference_type = std::ptrdiff_t;
+            using reference = const tree_node&;
+            using pointer = const tree_node*;
+            using iterator_category = std::forward_iterator_tag;
+
+            sibling_iterator() = default;
+            sibling_iterator(const node_arena* arena, uint32_t index) noexcept : m_arena{arena}, m_index{index} {}
+
+            reference operator*() const noexcept { return (*m_arena)[m_index]; }
+            pointer operator->() const noexcept { return &(*m_arena)[m_index]; }
+            [[nodiscard]] uint32_t index() const noexcept { return m_index; }
+
+            sibling_iterator& operator++() noexcept {
+                m_index = (*m_arena)[m_index].next_sibling;
+                return *this;
+            }
+
+            sibling_iterator operator++(int) noexcept {
+                auto retval = *this;
+                ++*this;
+                return retval;
+            }
+
+            friend bool operator==(const sibling_iterator& a, const sibling_iterator& b) noexcept {
+                return a.m_index == b.m_index;
+            }
+
+        private:
+            const node_arena* m_arena = nullptr;
+            uint32_t m_index = tree_node::npos;
+        };
+
+        struct sibling_range {
+            sibling_iterator first;
+
+            [[nodiscard]] sibling_iterator begin() const noexcept { return first; }
+            [[nodiscard]] sibling_iterator end() const noexcept { return {}; }
+            [[nodiscard]] bool empty() const noexcept { return first.index() == tree_node::npos; }
+        };
+
+        tree() = default;
+
+        /**
+         * Decodes a document into the arena in a single pass.
+         * @param arena Where the nodes go.  Nodes already in the arena are left alone.
+         * @param document The document, which may have several top-level elements.
+         * @param r The encoding rules of the document.
+         * @param out The decoded tree.
+         * @return decode_error::none on success, otherwise the first error found, in which
+         * case nothing is added to the arena.
+         */
+        static decode_error decode(node_arena& arena, std::span<const std::byte> document, rules r, tree& out);
+
+        [[nodiscard]] bool empty() const noexcept { return m_first == m_last; }
+        [[nodiscard]] std::size_t size() const noexcept { return m_last - m_first; }
+        [[nodiscard]] uint32_t root() const noexcept { return empty() ? tree_node::npos : m_first; }
+        [[nodiscard]] const tree_node& operator[](uint32_t i) const noexcept { return (*m_arena)[i]; }
+
+        /**
+         * The top-level elements.
+         */
+        [[nodiscard]] sibling_range roots() const noexcept { return {{m_arena, root()}}; }
+        [[nodiscard]] sibling_range children(uint32_t i) const noexcept { return {{m_arena, (*m_arena)[i].first_child}}; }
+
+        /**
+         * Finds the first child of a node with the given tag.
+         * @return The child's index, or tree_node::npos.
+         */
+        [[nodiscard]] uint32_t find_child(uint32_t i, const tag& t) const noexcept;
+
+    private:
+        template <typename Codec>
+        static decode_error decode_with(node_arena& arena, std::span<const std::byte> document, tree& out);
+
+        const node_arena* m_arena = nullptr;
+        uint32_t m_first = 0;
+        uint32_t m_last = 0;
+    };
+
+} /* namespace dabers */
+
+#endif //DABERS_TREE_H
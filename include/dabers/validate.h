@@ -0,0 +1,62 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_VALIDATE_H
+#define DABERS_VALIDATE_H
+
+#include "dabers/error.h"
+#include "dabers/rules.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace dabers {
+
+    /**
+     * The first problem validate found, if any.
+     */
+    struct validation_result {
+        decode_error error = decode_error::none;
+        /**
+         * The offset of the first identifier octet of the offending element from the start
+         * of the document.
+         */
+        uint64_t offset = 0;
+
+        [[nodiscard]] bool ok() const noexcept { return error == decode_error::none; }
+    };
+
+    /**
+     * The most levels of nesting validate goes into;  it keeps one entry per level on the
+     * stack rather than allocating.
+     */
+    constexpr std::size_t max_validate_depth = 64;
+
+    /**
+     * Checks a whole document is a valid encoding without building anything or decoding
+     * any values, e.g. to reject a certificate which isn't DER before doing anything else
+     * with it.  Every element is visited once, in order, and the check stops at the first
+     * problem.
+     *
+     * Under both sets of rules the headers must parse, every element must fit in its parent,
+     * constructed contents must be whole elements, the universal types which are always
+     * primitive (BOOLEAN, INTEGER, NULL, ...) or always constructed (SEQUENCE, SET, ...) must
+     * be, BOOLEAN and NULL must have the right length, INTEGER and ENUMERATED must be minimal
+     * and a BIT STRING's unused bit count must make sense.  DER adds (X.690 10 and 11):
+     * minimal length octets, no indefinite lengths, the primitive form for the string types,
+     * BOOLEAN TRUE as FF, zero unused bits in a BIT STRING, and SET components in order.
+     * Without a schema a SET can't be told from a SET OF, so a SET passes if its components
+     * are in either order:  ascending by tag (a SET) or by encoding (a SET OF).
+     * @param document The document, which may have several top-level elements.
+     * @return What was wrong and where, or decode_error::none.
+     */
+    template <typename Rules>
+        requires std::same_as<Rules, ber> || std::same_as<Rules, der>
+    validation_result validate(std::span<const std::byte> document) noexcept;
+
+} /* namespace dabers */
+
+#endif //DABERS_VALIDATE_H
@@ -8,14 +8,16 @@
 namespace dabers {
 
     void check_buffer(const std::byte* const begin, const std::byte* const end, const std::size_t min_size, const std::string_view context) {
-        if (begin == nullptr) {
-            throw_ex("Null beginning to buffer for '{}'.", context);
-        }
-        else if (end == nullptr) {
-            throw_ex("Null end to buffer for '{}'.", context);
-        }
-        else if (auto sz = std::distance(begin, end); sz < min_size) {
-            throw_ex("Buffer too small for '{}'.  Expected {} < {}.", context, sz, min_size);
+        switch (try_check_buffer(begin, end, min_size)) {
+            case decode_error::none:
+                return;
+            case decode_error::null_buffer:
+                if (begin == nullptr) {
+                    throw_ex("Null beginning to buffer for '{}'.", context);
+                }
+                throw_ex("Null end to buffer for '{}'.", context);
+            default:
+                throw_ex("Buffer too small for '{}'.  Expected {} < {}.", context, std::distance(begin, end), min_size);
         }
     }
 
@@ -26,4 +28,4 @@ namespace dabers {
         return retval;
     }
 
-} /* namespace dabers */
\ No newline at end of file
+} /* namespace dabers */
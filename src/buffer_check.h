@@ -5,11 +5,32 @@
 #ifndef DABERS_BUFFER_CHECK_H
 #define DABERS_BUFFER_CHECK_H
 
+#include "dabers/error.h"
+
 #include <cstddef>
 #include <string_view>
 
 namespace dabers {
 
+    inline decode_error try_check_buffer(const std::byte* const begin, const std::byte* const end, const std::size_t min_size) noexcept {
+        if (begin == nullptr || end == nullptr) {
+            return decode_error::null_buffer;
+        }
+        else if (static_cast<std::size_t>(end - begin) < min_size || end < begin) {
+            return decode_error::buffer_too_small;
+        }
+        return decode_error::none;
+    }
+
+    inline decode_error try_consume_buffer(const std::byte*& begin, const std::byte* const end, const std::size_t size, const std::byte*& consumed) noexcept {
+        if (auto err = try_check_buffer(begin, end, size); err != decode_error::none) {
+            return err;
+        }
+        consumed = begin;
+        begin += size;
+        return decode_error::none;
+    }
+
     void check_buffer(const std::byte* begin, const std::byte* end, std::size_t min_size, std::string_view context = "");
     const std::byte* consume_buffer(const std::byte*& begin, const std::byte* end, std::size_t size, std::string_view context = "");
 
@@ -0,0 +1,171 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/cer_encoder.h"
+#include "dabers/tlv_view.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace dabers {
+
+    namespace {
+
+        std::vector<std::byte> pattern(std::size_t size) {
+            std::vector<std::byte> retval(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                retval[i] = static_cast<std::byte>(i % 251);
+            }
+            return retval;
+        }
+
+        /**
+         * Puts a possibly segmented string back together, checking the segments are the
+         * size CER requires.
+         */
+        std::vector<std::byte> join_segments(const tlv_element& e, bool bits, std::size_t& segments) {
+            if (!e.constructed()) {
+                segments = 0;
+                return {e.contents().begin(), e.contents().end()};
+            }
+            std::vector<std::byte> retval;
+            segments = 0;
+            const auto payload = bits ? 999u : 1000u;
+            for (const auto& seg : e.children()) {
+                CHECK_FALSE(seg.constructed());
+                CHECK_EQ(seg.id().tag_number, bits ? 3u : 4u);
+                auto c = seg.contents();
+                if (bits) {
+                    c = c.subspan(1);
+                }
+                ++segments;
+                if (c.size() != payload) {
+                    //Only the last one may be short.
+                    CHECK_EQ(seg.encoded().data() + seg.encoded().size(), e.encoded().data() + e.encoded().size() - 2);
+                }
+                retval.insert(retval.end(), c.begin(), c.end());
+            }
+            return retval;
+        }
+
+        /**
+         * Takes a number of bytes and then throws.
+         */
+        struct limited_sink {
+            std::vector<std::byte>* out;
+            std::size_t limit;
+
+            void put(std::byte b) {
+                if (out->size() == limit) {
+                    throw std::length_error{"The sink is full."};
+                }
+                out->push_back(b);
+            }
+        };
+
+    }
+
+    TEST_CASE("cer_encoder constructed") {
+        std::vector<std::byte> out;
+        out.reserve(16);
+        cer_encoder enc{vector_sink{out}};
+        {
+            auto seq = enc.constructed(universal_tags::sequence::value);
+            CHECK_EQ(enc.depth(), 1);
+            enc.write_primitive(universal_tags::integer::value, to_bytes({0x05u}));
+            auto inner = enc.constructed(tag{tag_class_type::context_specific, false, 0});
+            enc.write_encoded(to_bytes({0x05u, 0x00u}));
+        }
+        CHECK_EQ(enc.depth(), 0);
+        CHECK_EQ(out, to_bytes({0x30u, 0x80u, 0x02u, 0x01u, 0x05u, 0xa0u, 0x80u, 0x05u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u}));
+    }
+
+    TEST_CASE("cer_encoder strings") {
+        //Small strings stay primitive, including one exactly a segment long.
+        std::vector<std::byte> out;
+        cer_encoder enc{vector_sink{out}};
+        enc.write_octet_string(to_bytes({0x61u, 0x62u}));
+        enc.write_bit_string(to_bytes({0xf0u}), 4);
+        CHECK_EQ(out, to_bytes({0x04u, 0x02u, 0x61u, 0x62u, 0x03u, 0x02u, 0x04u, 0xf0u}));
+
+        for (bool bits : {false, true}) {
+            for (std::size_t size : {0u, 999u, 1000u, 1001u, 1998u, 1999u, 2000u, 2001u, 12345u}) {
+                for (std::size_t chunk : {1u, 7u, 1000u, 4096u}) {
+                    const auto value = pattern(size);
+                    out.clear();
+                    cer_encoder e{vector_sink{out}};
+                    {
+                        auto s = bits ? e.bit_string() : e.octet_string();
+                        for (std::size_t i = 0; i < size; i += chunk) {
+                            s.write(std::span{value}.subspan(i, std::min(chunk, size - i)));
+                        }
+                        s.finish(bits && size > 0 ? 3 : 0);
+                    }
+
+                    auto elements = tlv_view{out, rules::cer};
+                    auto it = elements.begin();
+                    REQUIRE(it != elements.end());
+                    const auto contents_size = size + (bits ? 1 : 0);
+                    CHECK_EQ(it->constructed(), contents_size > 1000);
+                    std::size_t segments = 0;
+                    auto joined = it->constructed() ? join_segments(*it, bits, segments) :
+                                  std::vector<std::byte>(it->contents().begin() + (bits ? 1 : 0), it->contents().end());
+                    CHECK_EQ(joined, value);
+                    if (it->constructed()) {
+                        CHECK_EQ(segments, (size + (bits ? 998 : 999)) / (bits ? 999 : 1000));
+                    }
+                    CHECK_EQ(it->encoded().size(), out.size());
+                }
+            }
+        }
+    }
+
+    TEST_CASE("cer_encoder implicit string tag") {
+        std::vector<std::byte> out;
+        cer_encoder enc{vector_sink{out}};
+        enc.write_octet_string(pattern(1500), tag{tag_class_type::context_specific, false, 2});
+        CHECK_EQ(out[0], std::byte{0xa2u});
+        CHECK_EQ(out[1], std::byte{0x80u});
+        CHECK_EQ(out[2], std::byte{0x04u});
+    }
+
+    TEST_CASE("cer_encoder unwinding") {
+        //Nothing more is written for the scopes and strings an exception unwinds.
+        std::vector<std::byte> out;
+        out.reserve(16);
+        cer_encoder enc{vector_sink{out}};
+        try {
+            auto seq = enc.constructed(universal_tags::sequence::value);
+            auto s = enc.octet_string();
+            s.write(pattern(10));
+            throw std::runtime_error{"Encoding failed."};
+        }
+        catch (const std::runtime_error&) {}
+        CHECK_EQ(enc.depth(), 0);
+        CHECK_EQ(out, to_bytes({0x30u, 0x80u}));
+
+        //A sink's exception comes out of close() and finish(), but not the destructors.
+        std::vector<std::byte> limited;
+        {
+            cer_encoder full{limited_sink{&limited, 2}};
+            auto seq = full.constructed(universal_tags::sequence::value);
+            CHECK_THROWS_AS(seq.close(), std::length_error);
+        }
+        CHECK_EQ(limited, to_bytes({0x30u, 0x80u}));
+        limited.clear();
+        {
+            cer_encoder full{limited_sink{&limited, 4}};
+            auto seq = full.constructed(universal_tags::sequence::value);
+            auto s = full.octet_string();
+            s.write(pattern(10));
+            CHECK_THROWS_AS(s.finish(), std::length_error);
+        }
+        CHECK_EQ(limited, to_bytes({0x30u, 0x80u, 0x04u, 0x0au}));
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,499 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/character_string.h"
+#include "decode_detail.h"
+#include "exception.h"
+#include "simd_detail.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dabers {
+
+    namespace {
+
+        /**
+         * Which bytes a string type allows, in the forms each kernel wants.
+         */
+        struct charset {
+            std::array<bool, 256> allowed{};
+            /**
+             * Nibble classification for pshufb:  a byte is allowed when the entries for its
+             * low and high nibbles have a bit in common.  Each distinct set of allowed low
+             * nibbles gets its own bit, so this is exact as long as there are at most 8 of them.
+             */
+            std::array<uint8_t, 16> low{};
+            std::array<uint8_t, 16> high{};
+            /**
+             * The same set as inclusive ranges, for plain SSE2.
+             */
+            std::array<std::array<uint8_t, 2>, 8> ranges{};
+            std::size_t range_count = 0;
+            /**
+             * An allowed byte, to pad the end of a string out to a whole block.
+             */
+            std::byte filler{};
+        };
+
+        constexpr charset make_charset(bool (*pred)(unsigned int)) {
+            charset retval;
+            for (unsigned int c = 0; c < 256; ++c) {
+                retval.allowed[c] = pred(c);
+            }
+
+            std::array<uint16_t, 8> classes{};
+            std::size_t class_count = 0;
+            for (unsigned int h = 0; h < 16; ++h) {
+                uint16_t lows = 0;
+                for (unsigned int l = 0; l < 16; ++l) {
+                    if (retval.allowed[h * 16 + l]) {
+                        lows |= static_cast<uint16_t>(1u << l);
+                    }
+                }
+                if (lows == 0) {
+                    continue;
+                }
+                std::size_t k = 0;
+                while (k < class_count && classes[k] != lows) {
+                    ++k;
+                }
+                if (k == class_count) {
+                    if (class_count == classes.size()) {
+                        throw std::logic_error{"The character set needs more than 8 nibble classes."};
+                    }
+                    classes[class_count++] = lows;
+                }
+                retval.high[h] |= static_cast<uint8_t>(1u << k);
+                for (unsigned int l = 0; l < 16; ++l) {
+                    if ((lows & (1u << l)) != 0) {
+                        retval.low[l] |= static_cast<uint8_t>(1u << k);
+                    }
+                }
+            }
+
+            for (unsigned int c = 0; c < 256; ++c) {
+                if (!retval.allowed[c]) {
+                    continue;
+                }
+                if (c == 0 || !retval.allowed[c - 1]) {
+                    if (retval.range_count == retval.ranges.size()) {
+                        throw std::logic_error{"The character set needs more than 8 ranges."};
+                    }
+                    if (retval.range_count == 0) {
+                        retval.filler = std::byte{static_cast<uint8_t>(c)};
+                    }
+                    retval.ranges[retval.range_count][0] = static_cast<uint8_t>(c);
+                    ++retval.range_count;
+                }
+                retval.ranges[retval.range_count - 1][1] = static_cast<uint8_t>(c);
+            }
+            return retval;
+        }
+
+        constexpr std::array<charset, 5> CHARSETS{
+            //UTF-8 isn't a set of bytes and has its own kernel.
+            charset{},
+            make_charset([](unsigned int c){ return c == ' ' || (c >= '0' && c <= '9'); }),
+            make_charset([](unsigned int c){
+                return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                       c == ' ' || c == '\'' || c == '(' || c == ')' || c == '+' || c == ',' ||
+                       c == '-' || c == '.' || c == '/' || c == ':' || c == '=' || c == '?';
+            }),
+            make_charset([](unsigned int c){ return c < 0x80u; }),
+            make_charset([](unsigned int c){ return c >= 0x20u && c < 0x7fu; })
+        };
+
+#if defined(__SSSE3__)
+        /**
+         * 0xff for each byte of the block which isn't allowed.
+         */
+        template <typename V>
+        typename V::vec bad_chars(const charset& cs, const typename V::vec v) noexcept {
+            const auto cls = V::and_(V::lookup16(V::table(cs.low), V::and_(v, V::splat(0x0fu))),
+                                     V::lookup16(V::table(cs.high), V::high_nibbles(v)));
+            return V::eq(cls, V::zero());
+        }
+#elif defined(__SSE2__)
+        template <typename V>
+        typename V::vec bad_chars(const charset& cs, const typename V::vec v) noexcept {
+            //lo <= v <= hi is (v - lo) <= (hi - lo) unsigned, which is a saturating subtract to 0.
+            auto in = V::zero();
+            for (std::size_t r = 0; r < cs.range_count; ++r) {
+                const auto lo = cs.ranges[r][0];
+                const auto hi = cs.ranges[r][1];
+                in = V::or_(in, V::eq(V::subs(V::sub(v, V::splat(lo)), V::splat(static_cast<uint8_t>(hi - lo))), V::zero()));
+            }
+            return V::eq(in, V::zero());
+        }
+#endif
+
+#if defined(__SSE2__)
+        template <typename V>
+        bool block_chars(const charset& cs, const std::byte*& p, const std::byte* const end) noexcept {
+            auto bad = V::zero();
+            for (; static_cast<std::size_t>(end - p) >= V::width; p += V::width) {
+                bad = V::or_(bad, bad_chars<V>(cs, V::load(p)));
+            }
+            return !V::any(bad);
+        }
+
+        /**
+         * Checks what's left after the whole blocks by padding it out to a block with an
+         * allowed byte, which is also how most short strings are checked.
+         */
+        template <typename V>
+        bool padded_chars(const charset& cs, const std::byte* const p, const std::byte* const end) noexcept {
+            std::array<std::byte, V::width> buf{};
+            buf.fill(cs.filler);
+            std::memcpy(buf.data(), p, static_cast<std::size_t>(end - p));
+            return !V::any(bad_chars<V>(cs, V::load(buf.data())));
+        }
+#endif
+
+        bool valid_chars(const charset& cs, const std::span<const std::byte> s) noexcept {
+            if (s.empty()) {
+                return true;
+            }
+            const std::byte* p = s.data();
+            const std::byte* const end = p + s.size();
+            bool ok = true;
+#if defined(__AVX2__)
+            ok &= block_chars<detail::avx2_ops>(cs, p, end);
+#endif
+#if defined(__SSSE3__)
+            using ops = detail::ssse3_ops;
+#elif defined(__SSE2__)
+            using ops = detail::sse2_ops;
+#endif
+#if defined(__SSE2__)
+            ok &= block_chars<ops>(cs, p, end);
+            if (p != end) {
+                ok &= padded_chars<ops>(cs, p, end);
+            }
+            return ok;
+#else
+            for (; p != end; ++p) {
+                ok &= cs.allowed[std::to_integer<uint8_t>(*p)];
+            }
+            return ok;
+#endif
+        }
+
+        /**
+         * One character at a time, skipping runs of ASCII eight bytes at a time.  This is
+         * the fallback where there's no pshufb, and the reference the vector kernel is
+         * tested against.
+         */
+        bool scalar_utf8(const std::byte* p, const std::byte* const end) noexcept {
+            while (p != end) {
+                if (end - p >= static_cast<std::ptrdiff_t>(sizeof(uint64_t)) && (detail::load_le64(p) & 0x8080808080808080u) == 0) {
+                    p += sizeof(uint64_t);
+                    continue;
+                }
+                const auto c = std::to_integer<unsigned int>(*p);
+                if (c < 0x80u) {
+                    ++p;
+                    continue;
+                }
+                std::ptrdiff_t n = 0;
+                unsigned int lo = 0x80u;
+                unsigned int hi = 0xbfu;
+                if (c < 0xc2u) {
+                    //A continuation byte, or the lead byte of an overlong 2 byte form.
+                    return false;
+                }
+                else if (c < 0xe0u) {
+                    n = 1;
+                }
+                else if (c < 0xf0u) {
+                    n = 2;
+                    lo = c == 0xe0u ? 0xa0u : lo;
+                    hi = c == 0xedu ? 0x9fu : hi;
+                }
+                else if (c < 0xf5u) {
+                    n = 3;
+                    lo = c == 0xf0u ? 0x90u : lo;
+                    hi = c == 0xf4u ? 0x8fu : hi;
+                }
+                else {
+                    return false;
+                }
+                if (end - p <= n) {
+                    return false;
+                }
+                const auto second = std::to_integer<unsigned int>(p[1]);
+                if (second < lo || second > hi) {
+                    return false;
+                }
+                for (std::ptrdiff_t i = 2; i <= n; ++i) {
+                    if ((p[i] & std::byte{0xc0u}) != std::byte{0x80u}) {
+                        return false;
+                    }
+                }
+                p += n + 1;
+            }
+            return true;
+        }
+
+#if defined(__SSSE3__)
+        /*
+         * The lookup algorithm from Keiser and Lemire, "Validating UTF-8 In Less Than One
+         * Instruction Per Byte".  Each error is a bit, and a byte pair is invalid when the
+         * tables for the high and low nibbles of the first byte and the high nibble of the
+         * second byte have a bit in common.  Whether the second and third bytes after a 3 or
+         * 4 byte lead are continuations is checked separately.
+         */
+        constexpr uint8_t TOO_SHORT = 1u << 0;
+        constexpr uint8_t TOO_LONG = 1u << 1;
+        constexpr uint8_t OVERLONG_3 = 1u << 2;
+        constexpr uint8_t TOO_LARGE = 1u << 3;
+        constexpr uint8_t SURROGATE = 1u << 4;
+        constexpr uint8_t OVERLONG_2 = 1u << 5;
+        constexpr uint8_t TOO_LARGE_1000 = 1u << 6;
+        constexpr uint8_t OVERLONG_4 = 1u << 6;
+        constexpr uint8_t TWO_CONTS = 1u << 7;
+        constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+        constexpr std::array<uint8_t, 16> BYTE_1_HIGH{
+            //0_______ ASCII
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            //10______ continuation
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            //1100____, 1101____ 2 byte lead
+            TOO_SHORT | OVERLONG_2,
+            TOO_SHORT,
+            //1110____ 3 byte lead
+            TOO_SHORT | OVERLONG_3 | SURROGATE,
+            //1111____ 4 byte lead
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+        };
+
+        constexpr std::array<uint8_t, 16> BYTE_1_LOW{
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+            CARRY | OVERLONG_2,
+            CARRY,
+            CARRY,
+            CARRY | TOO_LARGE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000
+        };
+
+        constexpr std::array<uint8_t, 16> BYTE_2_HIGH{
+            //________ 0_______
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            //________ 1000____
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            //________ 1001____
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+            //________ 101_____
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            //________ 11______
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+        };
+
+        template <typename V>
+        class utf8_checker {
+        public:
+            void check(const typename V::vec input) noexcept {
+                if (V::high_bits(input) == 0) {
+                    //All ASCII, so the only possible error is a sequence cut off by this block.
+                    m_error = V::or_(m_error, m_prev_incomplete);
+                    m_prev_incomplete = V::zero();
+                }
+                else {
+                    const auto prev1 = V::template prev<1>(input, m_prev_input);
+                    const auto special = V::and_(V::and_(V::lookup16(m_byte_1_high, V::high_nibbles(prev1)),
+                                                         V::lookup16(m_byte_1_low, V::and_(prev1, V::splat(0x0fu)))),
+                                                 V::lookup16(m_byte_2_high, V::high_nibbles(input)));
+                    //Only 111_____ and 1111____ leave the top bit set.
+                    const auto third = V::subs(V::template prev<2>(input, m_prev_input), V::splat(0xe0u - 0x80u));
+                    const auto fourth = V::subs(V::template prev<3>(input, m_prev_input), V::splat(0xf0u - 0x80u));
+                    const auto must_continue = V::and_(V::or_(third, fourth), V::splat(0x80u));
+                    m_error = V::or_(m_error, V::xor_(must_continue, special));
+                    m_prev_incomplete = V::subs(input, m_max_complete);
+                }
+                m_prev_input = input;
+            }
+
+            [[nodiscard]] bool valid() const noexcept {
+                return !V::any(V::or_(m_error, m_prev_incomplete));
+            }
+
+        private:
+            static typename V::vec max_complete() noexcept {
+                //A block can't end in the lead byte of a sequence it doesn't have room for.
+                std::array<std::byte, V::width> m{};
+                m.fill(std::byte{0xffu});
+                m[V::width - 3] = std::byte{0xf0u - 1};
+                m[V::width - 2] = std::byte{0xe0u - 1};
+                m[V::width - 1] = std::byte{0xc0u - 1};
+                return V::load(m.data());
+            }
+
+            typename V::vec m_byte_1_high = V::table(BYTE_1_HIGH);
+            typename V::vec m_byte_1_low = V::table(BYTE_1_LOW);
+            typename V::vec m_byte_2_high = V::table(BYTE_2_HIGH);
+            typename V::vec m_max_complete = max_complete();
+            typename V::vec m_error = V::zero();
+            typename V::vec m_prev_input = V::zero();
+            typename V::vec m_prev_incomplete = V::zero();
+        };
+
+        template <typename V>
+        bool vector_utf8(const std::byte* p, const std::byte* const end) noexcept {
+            utf8_checker<V> checker;
+            for (; static_cast<std::size_t>(end - p) >= V::width; p += V::width) {
+                checker.check(V::load(p));
+            }
+            if (p != end) {
+                //Zeros are ASCII, so padding with them also catches a sequence cut off by the end.
+                std::array<std::byte, V::width> buf{};
+                std::memcpy(buf.data(), p, static_cast<std::size_t>(end - p));
+                checker.check(V::load(buf.data()));
+            }
+            return checker.valid();
+        }
+#endif
+
+        bool valid_utf8(const std::span<const std::byte> s) noexcept {
+            if (s.empty()) {
+                return true;
+            }
+#if defined(__AVX2__)
+            return vector_utf8<detail::avx2_ops>(s.data(), s.data() + s.size());
+#elif defined(__SSSE3__)
+            return vector_utf8<detail::ssse3_ops>(s.data(), s.data() + s.size());
+#else
+            return scalar_utf8(s.data(), s.data() + s.size());
+#endif
+        }
+
+    }
+
+    bool is_valid_string(const string_type type, const std::span<const std::byte> contents) noexcept {
+        return type == string_type::utf8 ? valid_utf8(contents) : valid_chars(CHARSETS[static_cast<std::size_t>(type)], contents);
+    }
+
+    decode_error try_decode_string(const string_type type, const std::span<const std::byte> contents, std::string_view& out) noexcept {
+        if (!is_valid_string(type, contents)) {
+            return type == string_type::utf8 ? decode_error::invalid_utf8 : decode_error::invalid_string_character;
+        }
+        out = std::string_view{reinterpret_cast<const char*>(contents.data()), contents.size()};
+        return decode_error::none;
+    }
+
+    std::string_view decode_string(const string_type type, const std::span<const std::byte> contents) {
+        std::string_view retval;
+        if (auto err = try_decode_string(type, contents, retval); err != decode_error::none) {
+            throw_decode_error(err, "character string");
+        }
+        return retval;
+    }
+
+    TEST_CASE("is_valid_string") {
+        CHECK(is_valid_string(string_type::printable, to_bytes("Example Org (Test) Ltd., CA=1/2:3?")));
+        CHECK_FALSE(is_valid_string(string_type::printable, to_bytes("user@example.com")));
+        CHECK_FALSE(is_valid_string(string_type::printable, to_bytes("a*b")));
+        CHECK(is_valid_string(string_type::numeric, to_bytes("0123 456789")));
+        CHECK_FALSE(is_valid_string(string_type::numeric, to_bytes("12a")));
+        CHECK(is_valid_string(string_type::ia5, to_bytes("user@example.com\r\n~")));
+        CHECK(is_valid_string(string_type::ia5, to_bytes(std::string_view{"\0\x7f", 2})));
+        CHECK_FALSE(is_valid_string(string_type::ia5, to_bytes("caf\xc3\xa9")));
+        CHECK(is_valid_string(string_type::visible, to_bytes("~!@#$%^&*()_+ {}|")));
+        CHECK_FALSE(is_valid_string(string_type::visible, to_bytes("tab\there")));
+        CHECK_FALSE(is_valid_string(string_type::visible, to_bytes("\x7f")));
+        CHECK(is_valid_string(string_type::numeric, {}));
+
+        //Every byte at every position of strings around the block sizes, against the table.
+        for (auto type : {string_type::numeric, string_type::printable, string_type::ia5, string_type::visible}) {
+            const auto& cs = CHARSETS[static_cast<std::size_t>(type)];
+            for (std::size_t len : {1u, 2u, 15u, 16u, 17u, 31u, 32u, 33u, 47u, 64u, 70u}) {
+                std::vector<std::byte> s(len, cs.filler);
+                for (std::size_t pos = 0; pos < len; pos += 3) {
+                    for (unsigned int c = 0; c < 256; ++c) {
+                        s[pos] = std::byte{static_cast<uint8_t>(c)};
+                        CHECK_EQ(is_valid_string(type, s), cs.allowed[c]);
+                    }
+                    s[pos] = cs.filler;
+                }
+            }
+        }
+
+        CHECK_EQ(string_type_of(universal_tags::printable_string::value), string_type::printable);
+        CHECK_EQ(string_type_of(universal_tags::utf8_string::value), string_type::utf8);
+        CHECK_FALSE(string_type_of(universal_tags::bmp_string::value).has_value());
+        CHECK_FALSE(string_type_of(tag{tag_class_type::context_specific, false, 19}).has_value());
+
+        const auto org = to_bytes("Example Org");
+        CHECK_EQ(decode_string(string_type::printable, org), "Example Org");
+        CHECK_EQ(static_cast<const void*>(decode_string(string_type::printable, org).data()), static_cast<const void*>(org.data()));
+        std::string_view view;
+        CHECK_EQ(try_decode_string(string_type::numeric, org, view), decode_error::invalid_string_character);
+        CHECK_EQ(try_decode_string(string_type::utf8, to_bytes("\xff"), view), decode_error::invalid_utf8);
+        CHECK_THROWS_AS(decode_string(string_type::ia5, to_bytes("\x80")), exception);
+    }
+
+    TEST_CASE("is_valid_string utf8") {
+        auto valid = [](std::string_view s){ return is_valid_string(string_type::utf8, to_bytes(s)); };
+        CHECK(valid(""));
+        CHECK(valid("plain ASCII"));
+        CHECK(valid("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 \xf4\x8f\xbf\xbf \xed\x9f\xbf"));
+        CHECK_FALSE(valid("\xc0\x80"));              //Overlong 2 byte
+        CHECK_FALSE(valid("\xc1\xbf"));
+        CHECK_FALSE(valid("\xe0\x80\x80"));         //Overlong 3 byte
+        CHECK_FALSE(valid("\xf0\x80\x80\x80"));     //Overlong 4 byte
+        CHECK_FALSE(valid("\xed\xa0\x80"));         //Surrogate
+        CHECK_FALSE(valid("\xf4\x90\x80\x80"));     //Over U+10FFFF
+        CHECK_FALSE(valid("\xf5\x80\x80\x80"));
+        CHECK_FALSE(valid("\x80"));                 //Lone continuation
+        CHECK_FALSE(valid("\xc3"));                 //Cut off
+        CHECK_FALSE(valid("abc\xe2\x82"));
+        CHECK_FALSE(valid("\xe2\x82" "a"));
+        CHECK_FALSE(valid("\xc3\xa9\xa9"));           //Too many continuations
+
+        //Random mixes of valid characters and damage, at every alignment, against the scalar
+        //  validator.  The vector kernels are only built with e.g. -mssse3, which is what
+        //  daBERs_simd_tests is for.
+        std::mt19937 rng{11};
+        const std::vector<std::string_view> pieces{"a", "Z0 ", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xef\xbf\xbf", "\xed\x9f\xbf"};
+        for (int i = 0; i < 5000; ++i) {
+            std::string s;
+            const auto len = rng() % 80;
+            while (s.size() < len) {
+                s += pieces[rng() % pieces.size()];
+            }
+            if (rng() % 2 == 0 && !s.empty()) {
+                s[rng() % s.size()] = static_cast<char>(rng());
+            }
+            const auto b = to_bytes(s);
+            const auto expected = scalar_utf8(b.data(), b.data() + b.size());
+            CHECK_EQ(is_valid_string(string_type::utf8, b), expected);
+#if defined(__SSSE3__)
+            CHECK_EQ(vector_utf8<detail::ssse3_ops>(b.data(), b.data() + b.size()), expected);
+#endif
+#if defined(__AVX2__)
+            CHECK_EQ(vector_utf8<detail::avx2_ops>(b.data(), b.data() + b.size()), expected);
+#endif
+        }
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,222 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_DECODE_DETAIL_H
+#define DABERS_DECODE_DETAIL_H
+
+#include "dabers/error.h"
+#include "dabers/length.h"
+#include "dabers/tag.h"
+
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace dabers::detail {
+
+    /**
+     * Ten base-128 groups hold a 64-bit tag number, as encode_tag writes them; the first of
+     * them can only be 1.
+     */
+    constexpr int MAX_TAG_NUM_LENGTH = 10;
+
+    /**
+     * The most bytes the tag and length decoders will read.  When at least this many bytes
+     * are available the unchecked decoders can be used.
+     */
+    constexpr std::size_t max_decoded_tag_size = 1 + MAX_TAG_NUM_LENGTH;
+    constexpr std::size_t max_decoded_length_size = max_encoded_length_size;
+    constexpr std::size_t max_decoded_header_size = max_decoded_tag_size + max_decoded_length_size;
+
+    constexpr uint64_t byte_swap(const uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(v);
+#else
+        uint64_t retval = 0;
+        for (int i = 0; i < 8; ++i) {
+            retval = (retval << CHAR_BIT) | ((v >> (i * CHAR_BIT)) & 0xffu);
+        }
+        return retval;
+#endif
+    }
+
+    /**
+     * Reads 8 bytes at p, which need not be aligned, as a big-endian integer.
+     */
+    inline uint64_t load_be64(const std::byte* const p) noexcept {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        if constexpr (std::endian::native == std::endian::little) {
+            v = byte_swap(v);
+        }
+        return v;
+    }
+
+    /**
+     * Reads 8 bytes at p, which need not be aligned, as a little-endian integer so the byte
+     * at p ends up in the low bits.
+     */
+    inline uint64_t load_le64(const std::byte* const p) noexcept {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        if constexpr (std::endian::native == std::endian::big) {
+            v = byte_swap(v);
+        }
+        return v;
+    }
+
+    /**
+     * Decodes a base-128 number (7 bits per byte, high bit set on all but the last byte)
+     * from the 8 bytes at p, all of which must be readable.  The terminating byte is found
+     * with a mask over all 8 bytes at once and the 7 bit groups are packed together with
+     * PEXT when the target has BMI2, or with three shift/mask steps otherwise.
+     * @return The number of bytes in the number, or 0 if none of the 8 bytes ends it.
+     */
+    inline unsigned int decode_base128_8(const std::byte* const p, uint64_t& out) noexcept {
+        const auto v = load_le64(p);
+        const auto stops = ~v & 0x8080808080808080u;
+        if (stops == 0) {
+            return 0;
+        }
+        const auto count = static_cast<unsigned int>(std::countr_zero(stops)) / CHAR_BIT + 1;
+        //Put the first byte at the top so the last group lands in the lowest bits, dropping
+        //  whatever follows the number.
+        const auto groups = byte_swap(v) >> ((sizeof(uint64_t) - count) * CHAR_BIT);
+#if defined(__BMI2__)
+        out = _pext_u64(groups, 0x7f7f7f7f7f7f7f7fu);
+#else
+        auto x = groups & 0x7f7f7f7f7f7f7f7fu;
+        x = ((x & 0x7f007f007f007f00u) >> 1) | (x & 0x007f007f007f007fu);
+        x = ((x & 0x3fff00003fff0000u) >> 2) | (x & 0x00003fff00003fffu);
+        x = ((x & 0x0fffffff00000000u) >> 4) | (x & 0x000000000fffffffu);
+        out = x;
+#endif
+        return count;
+    }
+
+    /**
+     * Decodes identifier octets starting at cur.  When Checked is false the caller guarantees
+     * that at least max_decoded_tag_size bytes are readable and end is ignored.  On success
+     * cur is moved past the identifier octets, on failure it is left untouched.  The buffer
+     * must be non-empty and non-null.
+     */
+    template <bool Checked>
+    inline decode_error decode_tag(const std::byte*& cur, [[maybe_unused]] const std::byte* const end, tag& out) noexcept {
+        const std::byte* p = cur;
+        const auto& first = identifier_octet_table[to_integer<uint8_t>(*p++)];
+        out.tag_class = first.tag_class;
+        out.constructed = first.constructed;
+        out.tag_number = first.tag_number;
+        if (first.long_form) [[unlikely]] {
+            if constexpr (Checked) {
+                if (p == end) {
+                    return decode_error::buffer_too_small;
+                }
+            }
+            if (*p == std::byte{0x80u}) {
+                return decode_error::tag_number_leading_zero;
+            }
+            if (!Checked || end - p >= static_cast<std::ptrdiff_t>(sizeof(uint64_t))) {
+                uint64_t num_bits = 0;
+                if (const auto count = decode_base128_8(p, num_bits)) [[likely]] {
+                    if (num_bits < 31) {
+                        return decode_error::tag_number_too_small;
+                    }
+                    out.tag_number = num_bits;
+                    cur = p + count;
+                    return decode_error::none;
+                }
+            }
+            //Near the end of the buffer, or the number is 9 or more bytes long.
+            uint64_t num_bits = 0;
+            int count = 0;
+            bool more = true;
+            while (more) {
+                if constexpr (Checked) {
+                    if (p == end) {
+                        return decode_error::buffer_too_small;
+                    }
+                }
+                if (count == MAX_TAG_NUM_LENGTH || (num_bits >> (64 - 7)) != 0) {
+                    return decode_error::tag_number_too_long;
+                }
+                const auto next = *p++;
+                more = (next & std::byte{0x80u}) != std::byte{0};
+                num_bits <<= 7;
+                num_bits |= static_cast<uint8_t>(next & std::byte{0x7fu});
+                ++count;
+            }
+            if (num_bits < 31) {
+                return decode_error::tag_number_too_small;
+            }
+            out.tag_number = num_bits;
+        }
+        cur = p;
+        return decode_error::none;
+    }
+
+    /**
+     * Decodes length octets starting at cur, with the same contract as decode_tag.
+     */
+    template <bool Checked>
+    inline decode_error decode_length(const length_options opts, const std::byte*& cur, [[maybe_unused]] const std::byte* const end,
+                                      std::optional<uint64_t>& out) noexcept {
+        const auto first = *cur;
+        if ((first & std::byte{0x80u}) == std::byte{0}) {
+            if (opts == length_options::indefinite_required) {
+                return decode_error::indefinite_length_required;
+            }
+            out = to_integer<uint64_t>(first);
+            cur += 1;
+            return decode_error::none;
+        }
+
+        const auto num_long_bytes = to_integer<uint32_t>(first & std::byte{0x7fu});
+        if (num_long_bytes == 0) {
+            if (opts == length_options::definite_required) {
+                return decode_error::indefinite_length_forbidden;
+            }
+            out = std::nullopt;
+            cur += 1;
+            return decode_error::none;
+        }
+        else if (opts == length_options::indefinite_required) {
+            return decode_error::indefinite_length_required;
+        }
+        else if (num_long_bytes > sizeof(uint64_t)) {
+            return decode_error::length_too_long;
+        }
+        if constexpr (Checked) {
+            const auto available = static_cast<std::size_t>(end - cur);
+            if (available < 1 + num_long_bytes) {
+                return decode_error::buffer_too_small;
+            }
+            else if (available < max_decoded_length_size) {
+                //Too close to the end for the wide load.
+                uint64_t retval = 0;
+                for (uint32_t i = 1; i <= num_long_bytes; ++i) {
+                    retval = (retval << CHAR_BIT) | to_integer<uint64_t>(cur[i]);
+                }
+                out = retval;
+                cur += 1 + num_long_bytes;
+                return decode_error::none;
+            }
+        }
+        //Load all 8 bytes that could follow and drop the ones past the length octets.  The
+        //  shift is never 64 since num_long_bytes is at least 1.
+        out = load_be64(cur + 1) >> ((sizeof(uint64_t) - num_long_bytes) * CHAR_BIT);
+        cur += 1 + num_long_bytes;
+        return decode_error::none;
+    }
+
+} /* namespace dabers::detail */
+
+#endif //DABERS_DECODE_DETAIL_H
@@ -0,0 +1,118 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/der_encoder.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace dabers {
+
+    void der_encoder::write_header(const tag& t, const uint64_t length) {
+        std::array<std::byte, max_encoded_tag_size + max_encoded_length_size> buf{};
+        auto size = encode_tag(t, buf.data());
+        size += encode_length(length, buf.data() + size);
+        prepend(buf.data(), size);
+    }
+
+    void der_encoder::close_scope(const tag& t, const uint64_t length) noexcept {
+        std::array<std::byte, max_header_size> buf{};
+        auto size = encode_tag(t, buf.data());
+        size += encode_length(length, buf.data() + size);
+        m_reserved -= max_header_size;
+        m_begin -= size;
+        std::memcpy(m_buf.data() + m_begin, buf.data(), size);
+    }
+
+    void der_encoder::grow(const std::size_t needed) {
+        const auto used = size();
+        const auto capacity = std::max({m_buf.size() * 2, used + m_reserved + needed, std::size_t{256}});
+        std::vector<std::byte> buf(capacity);
+        const auto begin = capacity - used;
+        std::copy(m_buf.begin() + static_cast<std::ptrdiff_t>(m_begin), m_buf.end(), buf.begin() + static_cast<std::ptrdiff_t>(begin));
+        m_buf = std::move(buf);
+        m_begin = begin;
+    }
+
+    std::vector<std::byte> der_encoder::release() {
+        const auto used = size();
+        if (m_begin != 0) {
+            std::memmove(m_buf.data(), m_buf.data() + m_begin, used);
+            m_buf.resize(used);
+        }
+        m_begin = 0;
+        return std::exchange(m_buf, {});
+    }
+
+    TEST_CASE("der_encoder") {
+        const auto expected = sample_der_document();
+        const auto integer = to_bytes({0x05u});
+        const auto boolean = to_bytes({0xffu});
+        const auto octets = to_bytes("ab");
+
+        //A tiny initial buffer makes sure growing keeps everything in place.
+        for (std::size_t initial : {0u, 4u, 1000u}) {
+            der_encoder enc{initial};
+            enc.write_primitive(universal_tags::null::value, {});
+            {
+                auto seq = enc.constructed(universal_tags::sequence::value);
+                enc.write_primitive(universal_tags::boolean::value, boolean);
+                {
+                    auto inner = enc.constructed(universal_tags::sequence::value);
+                    enc.constructed({tag_class_type::context_specific, false, 0}).close();
+                    enc.write_primitive(universal_tags::octet_string::value, octets);
+                }
+                enc.write_primitive(universal_tags::integer::value, integer);
+            }
+            CHECK(std::ranges::equal(enc.data(), expected));
+            auto released = enc.release();
+            CHECK_EQ(released, expected);
+            CHECK_EQ(enc.size(), 0u);
+        }
+
+        const std::vector<std::byte> big(300, std::byte{0x61u});
+        der_encoder enc;
+        enc.write_contents(big);
+        enc.write_header({tag_class_type::application, false, 1000}, big.size());
+        CHECK_EQ(enc.size(), 3u + 3u + big.size());
+        //A scope closed straight away is an empty constructed element.
+        auto s = enc.constructed({tag_class_type::universal, true, 16});
+        s.close();
+        CHECK_EQ(enc.size(), 3u + 3u + big.size() + 2u);
+        CHECK_EQ(enc.data()[0], std::byte{0x30u});
+        CHECK_EQ(enc.data()[1], std::byte{0x00u});
+        enc.clear();
+        CHECK_EQ(enc.size(), 0u);
+        enc.write_encoded(expected);
+        CHECK(std::ranges::equal(enc.data(), expected));
+
+        //Closing writes into the room reserved on opening, without moving anything.
+        der_encoder reserved{0};
+        {
+            auto seq = reserved.constructed(universal_tags::sequence::value);
+            reserved.write_primitive(universal_tags::octet_string::value, big);
+            const auto* before = reserved.data().data();
+            seq.close();
+            CHECK_EQ(reserved.data().data() + 4, before);
+        }
+        CHECK_EQ(reserved.size(), 4u + 4u + big.size());
+
+        //A scope unwound by an exception doesn't write a header for its partial contents.
+        der_encoder unwound;
+        try {
+            auto seq = unwound.constructed(universal_tags::sequence::value);
+            unwound.write_primitive(universal_tags::null::value, {});
+            throw std::runtime_error{"Encoding failed."};
+        }
+        catch (const std::runtime_error&) {}
+        CHECK_EQ(unwound.size(), 2u);
+        CHECK_EQ(unwound.data()[0], std::byte{0x05u});
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,193 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/der_set_of.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <random>
+
+namespace dabers {
+
+    namespace {
+
+        /**
+         * Ranges at most this long are finished with an insertion sort, which beats a pass
+         * over 257 buckets for a handful of entries.
+         */
+        constexpr std::size_t INSERTION_SORT_THRESHOLD = 16;
+
+        /**
+         * Bucket 0 is for components which have run out of octets; the rest are the octet values plus one.
+         */
+        constexpr std::size_t NUM_BUCKETS = 257;
+
+        /**
+         * The plain comparison sort, for checking the radix sort against.
+         */
+        bool padded_less(std::span<const std::byte> a, std::span<const std::byte> b) {
+            for (std::size_t i = 0; i < std::max(a.size(), b.size()); ++i) {
+                const auto x = i < a.size() ? a[i] : std::byte{0};
+                const auto y = i < b.size() ? b[i] : std::byte{0};
+                if (x != y) {
+                    return x < y;
+                }
+            }
+            return false;
+        }
+
+    }
+
+    void der_set_of::sort() {
+        if (m_sorted) {
+            return;
+        }
+        m_sorted = true;
+
+        const std::byte* const data = m_data.data();
+        //The octet at depth plus one, or 0 once the component has run out.
+        auto bucket = [data](const entry& e, const std::size_t depth) -> std::size_t {
+            return depth < e.size ? std::to_integer<std::size_t>(data[e.offset + depth]) + 1 : 0;
+        };
+        //Everything before depth is already known to be equal.
+        auto less_from = [data](const entry& a, const entry& b, const std::size_t depth) {
+            for (std::size_t d = depth; d < std::max(a.size, b.size); ++d) {
+                const auto x = d < a.size ? data[a.offset + d] : std::byte{0};
+                const auto y = d < b.size ? data[b.offset + d] : std::byte{0};
+                if (x != y) {
+                    return x < y;
+                }
+            }
+            return false;
+        };
+
+        auto& pending = m_pending;
+        pending.assign(1, {0, m_entries.size(), 0});
+        m_scratch.resize(m_entries.size());
+        std::array<std::size_t, NUM_BUCKETS + 1> counts{};
+
+        while (!pending.empty()) {
+            const auto r = pending.back();
+            pending.pop_back();
+            const auto first = m_entries.begin() + static_cast<std::ptrdiff_t>(r.begin);
+            const auto last = m_entries.begin() + static_cast<std::ptrdiff_t>(r.end);
+
+            if (r.end - r.begin <= INSERTION_SORT_THRESHOLD) {
+                for (auto it = first + 1; it < last; ++it) {
+                    const auto e = *it;
+                    auto hole = it;
+                    for (; hole != first && less_from(e, *(hole - 1), r.depth); --hole) {
+                        *hole = *(hole - 1);
+                    }
+                    *hole = e;
+                }
+                continue;
+            }
+
+            counts.fill(0);
+            for (auto it = first; it != last; ++it) {
+                ++counts[bucket(*it, r.depth) + 1];
+            }
+            //Components usually share a prefix (the tag, at least), which doesn't need a scatter.
+            if (const auto only = std::find(counts.begin(), counts.end(), r.end - r.begin); only != counts.end()) {
+                if (only != counts.begin() + 1) {
+                    pending.push_back({r.begin, r.end, r.depth + 1});
+                }
+                continue;
+            }
+            for (std::size_t b = 1; b < counts.size(); ++b) {
+                counts[b] += counts[b - 1];
+            }
+            //counts[b] is now where bucket b starts; scattering moves it up to where b + 1 starts.
+            for (auto it = first; it != last; ++it) {
+                m_scratch[r.begin + counts[bucket(*it, r.depth)]++] = *it;
+            }
+            std::copy(m_scratch.begin() + static_cast<std::ptrdiff_t>(r.begin),
+                      m_scratch.begin() + static_cast<std::ptrdiff_t>(r.end), first);
+            //Bucket 0 is done: those components are equal once padded.
+            for (std::size_t b = 1; b < NUM_BUCKETS; ++b) {
+                const auto start = counts[b - 1];
+                if (counts[b] - start > 1) {
+                    pending.push_back({r.begin + start, r.begin + counts[b], r.depth + 1});
+                }
+            }
+        }
+    }
+
+    void der_set_of::write(der_encoder& enc, tag t) {
+        sort();
+        auto s = enc.constructed(t);
+        for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) {
+            enc.write_encoded({m_data.data() + it->offset, it->size});
+        }
+    }
+
+    TEST_CASE("der_set_of order") {
+        der_set_of set;
+        for (const auto& v : std::vector<std::vector<unsigned int>>{
+                {0x04u, 0x02u, 0x61u, 0x62u},
+                {0x04u, 0x01u, 0x61u},
+                {0x02u, 0x01u, 0x05u},
+                {0x04u, 0x02u, 0x61u, 0x61u},
+                {0x04u, 0x01u, 0x00u},
+                {0x04u, 0x01u}}) {
+            set.add(to_bytes(v));
+        }
+        set.sort();
+        CHECK_EQ(std::vector<std::byte>(set[0].begin(), set[0].end()), to_bytes({0x02u, 0x01u, 0x05u}));
+        //Padded with zeros these two are equal, so either order is fine, but small sets keep
+        //  the order they were added in.
+        CHECK_EQ(std::vector<std::byte>(set[1].begin(), set[1].end()), to_bytes({0x04u, 0x01u, 0x00u}));
+        CHECK_EQ(std::vector<std::byte>(set[2].begin(), set[2].end()), to_bytes({0x04u, 0x01u}));
+        CHECK_EQ(std::vector<std::byte>(set[3].begin(), set[3].end()), to_bytes({0x04u, 0x01u, 0x61u}));
+        CHECK_EQ(std::vector<std::byte>(set[4].begin(), set[4].end()), to_bytes({0x04u, 0x02u, 0x61u, 0x61u}));
+        CHECK_EQ(std::vector<std::byte>(set[5].begin(), set[5].end()), to_bytes({0x04u, 0x02u, 0x61u, 0x62u}));
+
+        std::vector<std::byte> out;
+        set.write(vector_sink{out});
+        CHECK_EQ(out, to_bytes({0x31u, 0x13u,
+                                0x02u, 0x01u, 0x05u, 0x04u, 0x01u, 0x00u, 0x04u, 0x01u, 0x04u, 0x01u, 0x61u,
+                                0x04u, 0x02u, 0x61u, 0x61u, 0x04u, 0x02u, 0x61u, 0x62u}));
+
+        der_encoder enc;
+        set.write(enc);
+        CHECK(std::ranges::equal(enc.data(), out));
+
+        out.clear();
+        set.clear();
+        set.write(vector_sink{out}, tag{tag_class_type::context_specific, true, 1});
+        CHECK_EQ(out, to_bytes({0xa1u, 0x00u}));
+    }
+
+    TEST_CASE("der_set_of matches a comparison sort") {
+        std::mt19937_64 rng{17};
+        for (std::size_t count : {0u, 1u, 5u, 17u, 200u, 3000u}) {
+            der_set_of set;
+            std::vector<std::vector<std::byte>> expected;
+            for (std::size_t i = 0; i < count; ++i) {
+                //A shared prefix, then short runs over a tiny alphabet so there are lots of
+                //  ties, zero padding cases and deep buckets.
+                std::vector<std::byte> v{std::byte{0x30u}, std::byte{0x81u}};
+                const auto len = rng() % (i % 3 == 0 ? 40 : 6);
+                for (std::size_t j = 0; j < len; ++j) {
+                    v.push_back(static_cast<std::byte>(rng() % 3));
+                }
+                set.add(v);
+                expected.push_back(std::move(v));
+            }
+            std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b){ return padded_less(a, b); });
+            set.sort();
+            REQUIRE_EQ(set.size(), expected.size());
+            //Components which are equal once padded can come out in either order.
+            bool same = true;
+            for (std::size_t i = 0; i < count; ++i) {
+                same = same && !padded_less(set[i], expected[i]) && !padded_less(expected[i], set[i]);
+            }
+            CHECK(same);
+        }
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,100 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_ELEMENT_WALK_H
+#define DABERS_ELEMENT_WALK_H
+
+#include "dabers/error.h"
+#include "dabers/header.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dabers::detail {
+
+    /**
+     * The index of no element, as tape::npos and tree_node::npos.
+     */
+    constexpr uint32_t no_element = 0xffffffffu;
+
+    /**
+     * Walks every element of a document in order, keeping a stack of the open constructed
+     * elements so the headers are parsed with the tightest bound, for the builders which
+     * index a whole document (tape and tree).  Elements are numbered from first in the
+     * order they're found.
+     * @param open The stack, which needs index, last_child, end and indefinite members.  It
+     * is empty after the walk, but its storage can be reused.
+     * @param on_element Called as on_element(header, element, index, parent, prev_sibling)
+     * for each element, with element its first identifier octet and parent or prev_sibling
+     * no_element if there isn't one.  Returns a decode_error to stop the walk with.
+     * @param on_end_of_contents Called as on_end_of_contents(index, eoc) when the
+     * end-of-contents octets of an indefinite length element are found at eoc.
+     * @return decode_error::none, or the first problem found.
+     */
+    template <typename Codec, typename Open, typename OnElement, typename OnEndOfContents>
+    decode_error walk_elements(const std::span<const std::byte> document, std::vector<Open>& open, const uint32_t first,
+                               OnElement&& on_element, OnEndOfContents&& on_end_of_contents) {
+        const std::byte* cur = document.data();
+        const std::byte* const end = cur + document.size();
+        uint32_t index = first;
+        uint32_t last_top_level = no_element;
+        tlv_header h;
+
+        auto fail = [&open](decode_error err) {
+            open.clear();
+            return err;
+        };
+
+        open.clear();
+        while (true) {
+            //Close any definite length elements we've reached the end of.
+            while (!open.empty() && !open.back().indefinite && open.back().end == cur) {
+                open.pop_back();
+            }
+            const std::byte* const limit = open.empty() ? end : open.back().end;
+            if (cur == limit) {
+                if (!open.empty()) {
+                    //An indefinite length element without its end-of-contents octets.
+                    return fail(decode_error::buffer_too_small);
+                }
+                return decode_error::none;
+            }
+            else if (!open.empty() && open.back().indefinite &&
+                     limit - cur >= 2 && cur[0] == std::byte{0} && cur[1] == std::byte{0}) {
+                on_end_of_contents(open.back().index, cur);
+                cur += 2;
+                open.pop_back();
+                continue;
+            }
+
+            const std::byte* const element = cur;
+            if (auto err = Codec::try_parse_header(cur, limit, h); err != decode_error::none) {
+                return fail(err);
+            }
+            else if (index >= no_element) {
+                return fail(decode_error::too_many_elements);
+            }
+
+            const auto parent = open.empty() ? no_element : open.back().index;
+            uint32_t& prev_sibling = open.empty() ? last_top_level : open.back().last_child;
+            if (auto err = on_element(h, element, index, parent, prev_sibling); err != decode_error::none) {
+                return fail(err);
+            }
+            prev_sibling = index;
+
+            if (h.id.constructed) {
+                open.push_back({index, no_element, h.indefinite() ? limit : cur + h.contents.size(), h.indefinite()});
+            }
+            else {
+                cur += h.contents.size();
+            }
+            ++index;
+        }
+    }
+
+} /* namespace dabers::detail */
+
+#endif //DABERS_ELEMENT_WALK_H
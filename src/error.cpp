@@ -0,0 +1,51 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/error.h"
+
+namespace dabers {
+
+    std::string_view to_string(const decode_error e) noexcept {
+        switch (e) {
+            case decode_error::none: return "No error";
+            case decode_error::null_buffer: return "Null buffer";
+            case decode_error::buffer_too_small: return "Buffer too small";
+            case decode_error::tag_number_leading_zero: return "The first octet of an extended tag number cannot have 0 for the number bits";
+            case decode_error::tag_number_too_long: return "The length of the tag is more than the maximum supported by this library";
+            case decode_error::tag_number_too_small: return "The extended tag number cannot have a value less than 31 (0x1f)";
+            case decode_error::indefinite_length_forbidden: return "Indefinite length form found, but definite form was required";
+            case decode_error::indefinite_length_required: return "Definite length form found, but indefinite form was required";
+            case decode_error::length_too_long: return "The long form length is more than the maximum supported by this library";
+            case decode_error::too_many_elements: return "The document has more elements than can be indexed";
+            case decode_error::non_minimal_length: return "The length is not encoded in the minimum number of octets";
+            case decode_error::empty_integer: return "An INTEGER must have at least one contents octet";
+            case decode_error::non_minimal_integer: return "The first nine bits of an INTEGER cannot all be the same";
+            case decode_error::integer_out_of_range: return "The INTEGER value does not fit in the requested type";
+            case decode_error::empty_oid: return "An OBJECT IDENTIFIER must have at least one contents octet";
+            case decode_error::truncated_oid: return "The last subidentifier of the OBJECT IDENTIFIER is incomplete";
+            case decode_error::oid_arc_leading_zero: return "The first octet of a subidentifier cannot have 0 for the number bits";
+            case decode_error::oid_arc_too_long: return "The subidentifier is more than the maximum supported by this library";
+            case decode_error::invalid_string_character: return "The string contains a character its type does not allow";
+            case decode_error::invalid_utf8: return "The UTF8String is not valid UTF-8";
+            case decode_error::invalid_string_length: return "The string contents are not a whole number of characters";
+            case decode_error::unsupported_string_type: return "The tag is not a character string type this library supports";
+            case decode_error::invalid_time: return "The contents are not a valid UTCTime or GeneralizedTime";
+            case decode_error::non_canonical_time: return "The time is not in the form DER and CER require";
+            case decode_error::unexpected_end_of_contents: return "End-of-contents octets outside an indefinite length element";
+            case decode_error::primitive_encoding_required: return "The type must use the primitive form under these rules";
+            case decode_error::constructed_encoding_required: return "The type must use the constructed form";
+            case decode_error::invalid_boolean: return "A BOOLEAN must be one octet, and 00 or FF under DER";
+            case decode_error::invalid_null: return "A NULL cannot have any contents octets";
+            case decode_error::invalid_bit_string: return "The unused bits of the BIT STRING are invalid";
+            case decode_error::set_out_of_order: return "The components of the SET are not in DER order";
+            case decode_error::nesting_too_deep: return "The elements are nested more deeply than this library supports";
+            default: return "Unknown decode error";
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& os, const decode_error e) {
+        return os << to_string(e);
+    }
+
+} /* namespace dabers */
@@ -10,4 +10,8 @@ namespace dabers {
         throw exception{fmt::vformat(fmt_str, args)};
     }
 
-} /* namespace dabers */
\ No newline at end of file
+    void throw_decode_error(const decode_error err, const std::string_view context) {
+        throw_ex("Failed to decode {}: {}.", context, to_string(err));
+    }
+
+} /* namespace dabers */
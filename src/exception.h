@@ -5,6 +5,8 @@
 #ifndef DABERS_EXCEPTION_H
 #define DABERS_EXCEPTION_H
 
+#include "dabers/error.h"
+
 #include <stdexcept>
 #include <string_view>
 #include <fmt/core.h>
@@ -22,6 +24,14 @@ namespace dabers {
         throw_ex(fmt_str, {fmt::make_format_args(std::forward<Args>(args)...)});
     }
 
+    /**
+     * Throws the exception corresponding to an error code from one of the non-throwing
+     * functions.  This is how the throwing API is layered on top of the try_* functions.
+     * @param err The error, which must not be decode_error::none.
+     * @param context What was being decoded, for the message.
+     */
+    [[noreturn]] void throw_decode_error(decode_error err, std::string_view context);
+
 } /* namespace dabers */
 
 #endif //DABERS_EXCEPTION_H
@@ -0,0 +1,194 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/header.h"
+#include "dabers/codec.h"
+#include "dabers/length.h"
+#include "buffer_check.h"
+#include "decode_detail.h"
+#include "exception.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <vector>
+
+namespace dabers {
+
+    namespace {
+
+        template <bool Checked, typename Rules>
+        decode_error decode_header(const std::byte*& begin, const std::byte* const end, tlv_header& out) noexcept {
+            const std::byte* cur = begin;
+            if (auto err = detail::decode_tag<Checked>(cur, end, out.id); err != decode_error::none) {
+                return err;
+            }
+            if constexpr (Checked) {
+                if (cur == end) {
+                    return decode_error::buffer_too_small;
+                }
+            }
+            if (auto err = detail::decode_length<Checked>(length_options_for(Rules{}, out.id.constructed), cur, end, out.length);
+                    err != decode_error::none) {
+                return err;
+            }
+            const auto remaining = static_cast<uint64_t>(end - cur);
+            if (out.length) {
+                if (*out.length > remaining) {
+                    return decode_error::buffer_too_small;
+                }
+                out.contents = {cur, static_cast<std::size_t>(*out.length)};
+            }
+            else {
+                out.contents = {cur, static_cast<std::size_t>(remaining)};
+            }
+            out.header_size = static_cast<std::size_t>(cur - begin);
+            begin = cur;
+            return decode_error::none;
+        }
+
+        decode_error test_try_parse_header(rules r, const std::vector<unsigned int>& v) {
+            auto b = to_bytes(v);
+            const std::byte* beg = b.data();
+            tlv_header h;
+            return try_parse_header(r, beg, b.data() + b.size(), h);
+        }
+
+    }
+
+    namespace {
+
+        template <typename Rules>
+        decode_error parse_header_as(const std::byte*& begin, const std::byte* const end, tlv_header& out) noexcept {
+            if (auto err = try_check_buffer(begin, end, 2); err != decode_error::none) {
+                return err;
+            }
+            else if (static_cast<std::size_t>(end - begin) >= detail::max_decoded_header_size) {
+                return decode_header<false, Rules>(begin, end, out);
+            }
+            return decode_header<true, Rules>(begin, end, out);
+        }
+
+    }
+
+    decode_error try_parse_header(ber, const std::byte*& begin, const std::byte* const end, tlv_header& out) noexcept {
+        return parse_header_as<ber>(begin, end, out);
+    }
+
+    decode_error try_parse_header(cer, const std::byte*& begin, const std::byte* const end, tlv_header& out) noexcept {
+        return parse_header_as<cer>(begin, end, out);
+    }
+
+    decode_error try_parse_header(der, const std::byte*& begin, const std::byte* const end, tlv_header& out) noexcept {
+        return parse_header_as<der>(begin, end, out);
+    }
+
+    decode_error try_parse_header(const rules r, const std::byte*& begin, const std::byte* const end, tlv_header& out) noexcept {
+        return with_codec(r, [&](auto c){ return c.try_parse_header(begin, end, out); });
+    }
+
+    tlv_header parse_header(const rules r, const std::byte*& begin, const std::byte* const end) {
+        tlv_header retval;
+        if (auto err = try_parse_header(r, begin, end, retval); err != decode_error::none) {
+            throw_decode_error(err, "header");
+        }
+        return retval;
+    }
+
+    TEST_CASE("parse_header success") {
+        for (uint64_t num : {0ull, 16ull, 31ull, 200ull, 0x7fffffffffffffffull, 0xffffffffffffffffull}) {
+            for (uint64_t len : {0ull, 5ull, 127ull, 128ull, 300ull}) {
+                //Pad past the contents so both the checked and unchecked paths get used.
+                for (std::size_t padding : {0u, 20u}) {
+                    const tag t{tag_class_type::context_specific, num % 2 == 0, num};
+                    std::vector<std::byte> buf;
+                    write_tag(t, vector_sink{buf});
+                    write_length(der{}, t.constructed, len, vector_sink{buf});
+                    const auto header_size = buf.size();
+                    buf.resize(buf.size() + len + padding, std::byte{0x5au});
+
+                    const std::byte* beg = buf.data();
+                    auto h = parse_header(rules::der, beg, buf.data() + buf.size());
+                    CHECK_EQ(h.id, t);
+                    CHECK_EQ(h.length, len);
+                    CHECK_FALSE(h.indefinite());
+                    CHECK_EQ(h.header_size, header_size);
+                    CHECK_EQ(h.contents.data(), buf.data() + header_size);
+                    CHECK_EQ(h.contents.size(), len);
+                    CHECK_EQ(beg, buf.data() + header_size);
+                }
+            }
+        }
+
+        auto buf = to_bytes({0x30u, 0x80u, 0x02u, 0x01u, 0x05u, 0x00u, 0x00u});
+        const std::byte* beg = buf.data();
+        auto h = parse_header(ber{}, beg, buf.data() + buf.size());
+        CHECK_EQ(h.id, tag{tag_class_type::universal, true, 16});
+        CHECK(h.indefinite());
+        CHECK_EQ(h.header_size, 2u);
+        CHECK_EQ(h.contents.data(), buf.data() + 2);
+        CHECK_EQ(h.contents.size(), 5u);
+
+        beg = buf.data();
+        h = parse_header(cer{}, beg, buf.data() + buf.size());
+        CHECK(h.indefinite());
+    }
+
+    TEST_CASE("parse_header failures") {
+        CHECK_EQ(test_try_parse_header(rules::ber, {0x02u}), decode_error::buffer_too_small);
+        CHECK_EQ(test_try_parse_header(rules::ber, {0x1fu, 0x81u}), decode_error::buffer_too_small);
+        CHECK_EQ(test_try_parse_header(rules::ber, {0x02u, 0x02u, 0x01u}), decode_error::buffer_too_small);
+        CHECK_EQ(test_try_parse_header(rules::ber, {0x02u, 0x82u, 0x01u}), decode_error::buffer_too_small);
+        CHECK_EQ(test_try_parse_header(rules::ber, {0x02u, 0x80u, 0x00u, 0x00u}), decode_error::indefinite_length_forbidden);
+        CHECK_EQ(test_try_parse_header(rules::der, {0x30u, 0x80u, 0x00u, 0x00u}), decode_error::indefinite_length_forbidden);
+        CHECK_EQ(test_try_parse_header(rules::cer, {0x30u, 0x00u}), decode_error::indefinite_length_required);
+        CHECK_EQ(test_try_parse_header(rules::ber, {0x1fu, 0x05u, 0x00u}), decode_error::tag_number_too_small);
+
+        //Content length past the end of a buffer long enough for the unchecked path.
+        std::vector<unsigned int> v{0x04u, 0x81u, 0xffu};
+        v.resize(40, 0u);
+        CHECK_EQ(test_try_parse_header(rules::ber, v), decode_error::buffer_too_small);
+
+        auto buf = to_bytes({0x04u, 0x05u, 0x01u});
+        const std::byte* beg = buf.data();
+        CHECK_THROWS_AS(parse_header(rules::ber, beg, buf.data() + buf.size()), exception);
+    }
+
+    TEST_CASE("codec") {
+        CHECK_EQ(with_codec(rules::ber, [](auto c){ return c.runtime_rules; }), rules::ber);
+        CHECK_EQ(with_codec(rules::cer, [](auto c){ return c.runtime_rules; }), rules::cer);
+        CHECK_EQ(with_codec(rules::der, [](auto c){ return c.runtime_rules; }), rules::der);
+        static_assert(codec<cer>::decode_length_options(true) == length_options::indefinite_required);
+        static_assert(codec<ber>::encode_length_options(true) == length_options::definite_required);
+
+        const tag seq{tag_class_type::universal, true, 16};
+        const tag octets{tag_class_type::universal, false, 4};
+        std::vector<std::byte> buf;
+        CHECK_FALSE(codec<der>::write_header(seq, 300, vector_sink{buf}));
+        CHECK_EQ(buf, to_bytes({0x30u, 0x82u, 0x01u, 0x2cu}));
+        buf.clear();
+        CHECK(codec<cer>::write_header(seq, 300, vector_sink{buf}));
+        CHECK_FALSE(codec<cer>::write_header(octets, 3, vector_sink{buf}));
+        CHECK_EQ(buf, to_bytes({0x30u, 0x80u, 0x04u, 0x03u}));
+
+        //A length of 5 in two octets is fine for BER, but not the other two.
+        buf = to_bytes({0x04u, 0x81u, 0x05u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u});
+        for (auto r : {rules::ber, rules::cer, rules::der}) {
+            with_codec(r, [&](auto c){
+                const std::byte* beg = buf.data();
+                tlv_header h;
+                REQUIRE_EQ(c.try_parse_header(beg, buf.data() + buf.size(), h), decode_error::none);
+                CHECK_EQ(h.length, 5u);
+                CHECK_EQ(c.validate_header(h), r == rules::ber ? decode_error::none : decode_error::non_minimal_length);
+            });
+        }
+        const std::byte* beg = buf.data() + 3;
+        tlv_header h;
+        buf[3] = std::byte{0x04u};
+        buf[4] = std::byte{0x02u};
+        REQUIRE_EQ(codec<der>::try_parse_header(beg, buf.data() + buf.size(), h), decode_error::none);
+        CHECK_EQ(codec<der>::validate_header(h), decode_error::none);
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,165 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/integer.h"
+#include "decode_detail.h"
+#include "exception.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace dabers {
+
+    namespace {
+
+        void store_high(const uint64_t v, std::byte* const out, const std::size_t n) noexcept {
+            auto be = v;
+            if constexpr (std::endian::native == std::endian::little) {
+                be = detail::byte_swap(be);
+            }
+            std::memcpy(out, &be, n);
+        }
+
+        template <typename T>
+        decode_error test_decode(const std::vector<unsigned int>& v, T& out) {
+            auto b = to_bytes(v);
+            return try_decode_integer(b, out);
+        }
+
+    }
+
+    int64_t decode_integer(const std::span<const std::byte> contents) {
+        int64_t retval = 0;
+        if (auto err = try_decode_integer(contents, retval); err != decode_error::none) {
+            throw_decode_error(err, "integer");
+        }
+        return retval;
+    }
+
+    std::size_t encode_integer(const int64_t v, std::byte* const out) noexcept {
+        const auto n = encoded_integer_size(v);
+        store_high(static_cast<uint64_t>(v) << ((sizeof(int64_t) - n) * 8), out, n);
+        return n;
+    }
+
+    std::size_t encode_integer(const uint64_t v, std::byte* const out) noexcept {
+        const auto n = encoded_integer_size(v);
+        if (n > sizeof(uint64_t)) {
+            out[0] = std::byte{0};
+            store_high(v, out + 1, sizeof(uint64_t));
+        }
+        else {
+            store_high(v << ((sizeof(uint64_t) - n) * 8), out, n);
+        }
+        return n;
+    }
+
+    TEST_CASE("decode_integer") {
+        int64_t s = 0;
+        uint64_t u = 0;
+        CHECK_EQ(test_decode({0x00u}, s), decode_error::none);
+        CHECK_EQ(s, 0);
+        CHECK_EQ(test_decode({0x7fu}, s), decode_error::none);
+        CHECK_EQ(s, 127);
+        CHECK_EQ(test_decode({0x80u}, s), decode_error::none);
+        CHECK_EQ(s, -128);
+        CHECK_EQ(test_decode({0x00u, 0x80u}, s), decode_error::none);
+        CHECK_EQ(s, 128);
+        CHECK_EQ(test_decode({0xffu, 0x7fu}, s), decode_error::none);
+        CHECK_EQ(s, -129);
+        CHECK_EQ(test_decode({0x80u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u}, s), decode_error::none);
+        CHECK_EQ(s, std::numeric_limits<int64_t>::min());
+        CHECK_EQ(test_decode({0x00u, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu}, u), decode_error::none);
+        CHECK_EQ(u, std::numeric_limits<uint64_t>::max());
+
+        CHECK_EQ(test_decode({}, s), decode_error::empty_integer);
+        CHECK_EQ(test_decode({0x00u, 0x7fu}, s), decode_error::non_minimal_integer);
+        CHECK_EQ(test_decode({0xffu, 0x80u}, s), decode_error::non_minimal_integer);
+        CHECK_EQ(test_decode({0x00u, 0x80u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u}, s), decode_error::integer_out_of_range);
+        CHECK_EQ(test_decode({0xffu}, u), decode_error::integer_out_of_range);
+        CHECK_EQ(test_decode({0x01u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u}, u), decode_error::integer_out_of_range);
+        CHECK_THROWS_AS(decode_integer({}), exception);
+    }
+
+    TEST_CASE("encode_integer") {
+        std::array<std::byte, max_encoded_integer_size> buf{};
+        auto check = [&](auto v, const std::vector<unsigned int>& exp) {
+            const auto n = encode_integer(v, buf.data());
+            CHECK_EQ(n, encoded_integer_size(v));
+            CHECK_EQ(std::vector<std::byte>(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(n)), to_bytes(exp));
+        };
+        check(int64_t{0}, {0x00u});
+        check(int64_t{127}, {0x7fu});
+        check(int64_t{128}, {0x00u, 0x80u});
+        check(int64_t{-1}, {0xffu});
+        check(int64_t{-128}, {0x80u});
+        check(int64_t{-129}, {0xffu, 0x7fu});
+        check(std::numeric_limits<int64_t>::max(), {0x7fu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu});
+        check(uint64_t{255}, {0x00u, 0xffu});
+        check(uint64_t{1} << 63, {0x00u, 0x80u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u});
+
+        std::vector<std::byte> out;
+        write_integer(int64_t{-129}, vector_sink{out});
+        CHECK_EQ(out, to_bytes({0x02u, 0x02u, 0xffu, 0x7fu}));
+
+        //Round trips at every width, both signs.
+        std::mt19937_64 rng{3};
+        std::size_t mismatches = 0;
+        for (int bits = 0; bits <= 64; ++bits) {
+            for (int trial = 0; trial < 50; ++trial) {
+                const auto raw = bits == 0 ? 0 : rng() >> (64 - bits);
+                for (auto v : {static_cast<int64_t>(raw), -static_cast<int64_t>(raw), static_cast<int64_t>(~raw)}) {
+                    int64_t back = 0;
+                    const auto n = encode_integer(v, buf.data());
+                    if (try_decode_integer({buf.data(), n}, back) != decode_error::none || back != v) {
+                        ++mismatches;
+                    }
+                }
+                uint64_t back = 0;
+                const auto n = encode_integer(raw, buf.data());
+                if (try_decode_integer({buf.data(), n}, back) != decode_error::none || back != raw) {
+                    ++mismatches;
+                }
+            }
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+
+    TEST_CASE("big_integer_view") {
+        //A 2048 bit modulus with its sign octet.
+        std::vector<std::byte> modulus(257, std::byte{0xc5u});
+        modulus[0] = std::byte{0};
+        big_integer_view v;
+        REQUIRE_EQ(big_integer_view::from_contents(modulus, v), decode_error::none);
+        CHECK_FALSE(v.negative());
+        CHECK_EQ(v.bytes().data(), modulus.data());
+        CHECK_EQ(v.magnitude().data(), modulus.data() + 1);
+        CHECK_EQ(v.magnitude().size(), 256u);
+        CHECK_EQ(v.bit_width(), 2048u);
+        int64_t s = 0;
+        CHECK_EQ(v.to(s), decode_error::integer_out_of_range);
+
+        auto small = to_bytes({0x01u, 0x00u, 0x01u});
+        REQUIRE_EQ(big_integer_view::from_contents(small, v), decode_error::none);
+        CHECK_EQ(v.bit_width(), 17u);
+        CHECK_EQ(v.to(s), decode_error::none);
+        CHECK_EQ(s, 65537);
+
+        auto zero = to_bytes({0x00u});
+        REQUIRE_EQ(big_integer_view::from_contents(zero, v), decode_error::none);
+        CHECK(v.magnitude().empty());
+        CHECK_EQ(v.bit_width(), 0u);
+
+        auto neg = to_bytes({0xffu, 0x00u});
+        REQUIRE_EQ(big_integer_view::from_contents(neg, v), decode_error::none);
+        CHECK(v.negative());
+        CHECK_EQ(big_integer_view::from_contents(to_bytes({0x00u, 0x01u}), v), decode_error::non_minimal_integer);
+    }
+
+} /* namespace dabers */
@@ -5,76 +5,219 @@
 #include "dabers/length.h"
 #include "exception.h"
 #include "buffer_check.h"
+#include "decode_detail.h"
+#include "test_util.h"
 
-#include <array>
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
 
 namespace dabers {
 
-    std::optional<uint64_t> parse_length(const length_options opts, const std::byte*& begin, const std::byte* const end) {
-        auto* first = consume_buffer(begin, end, 1);
-        bool long_form = (*first & std::byte{0x80u}) != std::byte{0};
-        if (long_form) {
-            auto num_long_bytes = to_integer<uint32_t>(*first & std::byte{0x7fu});
-            if (num_long_bytes == 0) {
-                if (opts == length_options::definite_required) {
-                    throw_ex("Indefinite length form found, but definite form was required.");
-                }
-                return std::nullopt;
+    namespace {
+
+        std::optional<uint64_t> test_parse_length(length_options opts, const std::vector<unsigned int>& v) {
+            auto b = to_bytes(v);
+            const std::byte* beg = b.data();
+            return parse_length(opts, beg, b.data() + b.size());
+        }
+
+        decode_error test_try_parse_length(length_options opts, const std::vector<unsigned int>& v) {
+            auto b = to_bytes(v);
+            const std::byte* beg = b.data();
+            std::optional<uint64_t> len;
+            return try_parse_length(opts, beg, b.data() + b.size(), len);
+        }
+
+        /**
+         * A straightforward decoder to check the real one against.  Returns the number of
+         * bytes consumed, or 0 on failure.
+         */
+        std::size_t reference_decode_length(length_options opts, std::span<const std::byte> buf, std::optional<uint64_t>& out) {
+            if (buf.empty()) {
+                return 0;
             }
-            else {
-                if (opts == length_options::indefinite_required) {
-                    throw_ex("Definite length form found, but indefinite form was required.");
-                }
-                else if (num_long_bytes > sizeof(uint64_t)) {
-                    throw_ex("The long form length ({}) is more than the "
-                             "maximum supported by this library ({}).",
-                             num_long_bytes, sizeof(uint64_t));
-                }
-                auto* buf = consume_buffer(begin, end, num_long_bytes);
-                std::array<std::byte, sizeof(uint64_t)> arr{};
-                std::memcpy(arr.data() + sizeof(uint64_t) - num_long_bytes, buf, num_long_bytes);
-                uint64_t retval = 0;
-                std::memcpy(&retval, arr.data(), arr.size());
-                return retval;
+            const auto first = std::to_integer<unsigned int>(buf[0]);
+            if (first == 0x80u) {
+                out = std::nullopt;
+                return opts == length_options::definite_required ? 0 : 1;
             }
-        }
-        else {
-            if (opts == length_options::indefinite_required) {
-                throw_ex("Short form length field is invalid when the indefinite length form is required.");
+            else if (opts == length_options::indefinite_required) {
+                return 0;
+            }
+            else if (first < 0x80u) {
+                out = first;
+                return 1;
             }
-            return static_cast<uint64_t>(*first);
+            const auto n = first & 0x7fu;
+            if (n > 8 || buf.size() < 1 + n) {
+                return 0;
+            }
+            uint64_t v = 0;
+            for (unsigned int i = 1; i <= n; ++i) {
+                v = v * 256 + std::to_integer<unsigned int>(buf[i]);
+            }
+            out = v;
+            return 1 + n;
+        }
+
+        bool test_write_length(uint64_t len, length_options opts, const std::vector<unsigned int>& exp) {
+            std::vector<std::byte> output;
+            write_length(len, opts, vector_sink{output});
+            return output == to_bytes(exp);
+        }
+
+    }
+
+    decode_error try_parse_length(const length_options opts, const std::byte*& begin, const std::byte* const end, std::optional<uint64_t>& out) noexcept {
+        if (auto err = try_check_buffer(begin, end, 1); err != decode_error::none) {
+            return err;
+        }
+        else if (static_cast<std::size_t>(end - begin) >= detail::max_decoded_length_size) {
+            return detail::decode_length<false>(opts, begin, end, out);
+        }
+        return detail::decode_length<true>(opts, begin, end, out);
+    }
+
+    std::optional<uint64_t> parse_length(const length_options opts, const std::byte*& begin, const std::byte* const end) {
+        std::optional<uint64_t> retval;
+        if (auto err = try_parse_length(opts, begin, end, retval); err != decode_error::none) {
+            throw_decode_error(err, "length");
         }
+        return retval;
     }
 
     bool write_length(const uint64_t len, const length_options opts, const std::function<void(std::byte)>& output) {
-        if (opts == length_options::indefinite_required) {
-            output(std::byte{0x80u});
-            return true;
+        return write_length(len, opts, function_sink<const std::function<void(std::byte)>>{output});
+    }
+
+    namespace detail {
+        void throw_invalid_length_option(const length_options opts, const uint64_t len) {
+            throw_ex("Invalid length option ({}) for writing the length ({}).", static_cast<int>(opts), len);
         }
-        else if (opts == length_options::definite_required) {
-            if (len < 128) {
-                output(std::byte{static_cast<uint8_t>(len)});
-            }
-            else {
-                uint8_t num_len = 8;
-                uint64_t mask = 0xff00000000000000u;
-                bool started = false;
-                while (num_len > 0) {
-                    if (auto v = mask & len; v) {
-                        if (!started) {
-                            output(std::byte{0x80u} | std::byte{num_len});
+    } /* namespace detail */
+
+    TEST_CASE("parse_length success") {
+        CHECK_EQ(test_parse_length(length_options::definite_required, {0x00u}), 0u);
+        CHECK_EQ(test_parse_length(length_options::definite_required, {0x7fu}), 127u);
+        CHECK_EQ(test_parse_length(length_options::definite_required, {0x81u, 0x80u}), 128u);
+        CHECK_EQ(test_parse_length(length_options::definite_required, {0x82u, 0x01u, 0x02u}), 0x0102u);
+        CHECK_EQ(test_parse_length(length_options::indefinite_optional, {0x83u, 0x01u, 0x02u, 0x03u, 0xffu}), 0x010203u);
+        CHECK_EQ(test_parse_length(length_options::definite_required, {0x88u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u}), 0x0102030405060708u);
+        CHECK_EQ(test_parse_length(length_options::indefinite_optional, {0x80u}), std::nullopt);
+        CHECK_EQ(test_parse_length(length_options::indefinite_required, {0x80u}), std::nullopt);
+
+        //Check with buffer with extra data.
+        std::vector<std::byte> buf{std::byte{0x82u}, std::byte{0x01u}, std::byte{0x00u}, std::byte{0x04u}};
+        const std::byte* beg = buf.data();
+        CHECK_EQ(parse_length(length_options::definite_required, beg, buf.data() + buf.size()), 256u);
+        CHECK_EQ(*beg, std::byte{0x04u});
+    }
+
+    TEST_CASE("parse_length failures") {
+        CHECK_THROWS_AS(test_parse_length(length_options::definite_required, {}), exception);
+        CHECK_THROWS_AS(test_parse_length(length_options::definite_required, {0x80u}), exception);
+        CHECK_THROWS_AS(test_parse_length(length_options::indefinite_required, {0x05u}), exception);
+        CHECK_THROWS_AS(test_parse_length(length_options::indefinite_required, {0x81u, 0x80u}), exception);
+        CHECK_THROWS_AS(test_parse_length(length_options::definite_required, {0x82u, 0x01u}), exception);
+        CHECK_THROWS_AS(test_parse_length(length_options::definite_required, {0x89u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u}), exception);
+    }
+
+    TEST_CASE("try_parse_length") {
+        CHECK_EQ(test_try_parse_length(length_options::definite_required, {0x81u, 0x80u}), decode_error::none);
+        CHECK_EQ(test_try_parse_length(length_options::definite_required, {0x80u}), decode_error::indefinite_length_forbidden);
+        CHECK_EQ(test_try_parse_length(length_options::indefinite_required, {0x05u}), decode_error::indefinite_length_required);
+        CHECK_EQ(test_try_parse_length(length_options::indefinite_required, {0x81u, 0x80u}), decode_error::indefinite_length_required);
+        CHECK_EQ(test_try_parse_length(length_options::definite_required, {0x82u, 0x01u}), decode_error::buffer_too_small);
+        CHECK_EQ(test_try_parse_length(length_options::definite_required, {0x89u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u}), decode_error::length_too_long);
+
+        //The buffer shouldn't move on failure.
+        std::vector<std::byte> buf{std::byte{0x84u}, std::byte{0x01u}, std::byte{0x02u}};
+        const std::byte* beg = buf.data();
+        std::optional<uint64_t> len;
+        CHECK_EQ(try_parse_length(length_options::definite_required, beg, buf.data() + buf.size(), len), decode_error::buffer_too_small);
+        CHECK_EQ(beg, buf.data());
+    }
+
+    TEST_CASE("parse_length matches reference") {
+        //Every first octet, with every buffer size from nothing past it up to enough for the
+        //  wide load, so both the careful path near the end of a buffer and the wide load are hit.
+        std::mt19937_64 rng{7};
+        std::size_t mismatches = 0;
+        for (auto opts : {length_options::definite_required, length_options::indefinite_optional, length_options::indefinite_required}) {
+            for (unsigned int first = 0; first < 256; ++first) {
+                for (int trial = 0; trial < 4; ++trial) {
+                    std::vector<std::byte> full(12);
+                    full[0] = static_cast<std::byte>(first);
+                    for (std::size_t i = 1; i < full.size(); ++i) {
+                        full[i] = static_cast<std::byte>(trial == 0 ? 0xffu : trial == 1 ? 0x00u : rng() & 0xffu);
+                    }
+                    for (std::size_t size = 1; size <= full.size(); ++size) {
+                        std::vector<std::byte> buf{full.begin(), full.begin() + static_cast<std::ptrdiff_t>(size)};
+                        std::optional<uint64_t> expected, actual;
+                        const auto consumed = reference_decode_length(opts, buf, expected);
+                        const std::byte* beg = buf.data();
+                        const auto err = try_parse_length(opts, beg, buf.data() + buf.size(), actual);
+                        const bool match = consumed == 0 ?
+                                err != decode_error::none && beg == buf.data() :
+                                err == decode_error::none && actual == expected && beg == buf.data() + consumed;
+                        if (!match) {
+                            ++mismatches;
                         }
-                        started = true;
-                        --num_len;
-                        output(std::byte{static_cast<uint8_t>(v >> (num_len * CHAR_BIT))});
                     }
                 }
             }
-            return false;
         }
-        else {
-            throw_ex("Invalid length option ({}) for writing the length ({}).", static_cast<int>(opts), len);
+        CHECK_EQ(mismatches, 0);
+    }
+
+    TEST_CASE("write_length success") {
+        CHECK(test_write_length(0u, length_options::definite_required, {0x00u}));
+        CHECK(test_write_length(127u, length_options::definite_required, {0x7fu}));
+        CHECK(test_write_length(128u, length_options::definite_required, {0x81u, 0x80u}));
+        CHECK(test_write_length(256u, length_options::definite_required, {0x82u, 0x01u, 0x00u}));
+        CHECK(test_write_length(0x010203u, length_options::definite_required, {0x83u, 0x01u, 0x02u, 0x03u}));
+        CHECK(test_write_length(0xffffffffffffffffu, length_options::definite_required, {0x88u, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu}));
+        CHECK(test_write_length(1000u, length_options::indefinite_required, {0x80u}));
+
+        //Round trip through the parser, with each kind of output.
+        std::array<std::byte, max_encoded_length_size> by_span_check{};
+        for (uint64_t len : {0ull, 1ull, 127ull, 128ull, 255ull, 256ull, 65535ull, 65536ull, 0x0102030405ull, 0x7fffffffffffffffull}) {
+            std::vector<std::byte> by_sink, by_iter, by_func;
+            CHECK_EQ(encoded_length_size(len), encode_length(len, by_span_check.data()));
+            std::array<std::byte, max_encoded_length_size> by_span{};
+            std::vector<char> by_char;
+            CHECK_FALSE(write_length(der{}, false, len, vector_sink{by_sink}));
+            CHECK_FALSE(write_length(rules::der, true, len, std::back_inserter(by_iter)));
+            CHECK_FALSE(write_length(len, length_options::definite_required, [&by_func](std::byte b){ by_func.push_back(b); }));
+            span_sink ss{by_span.data(), by_span.data() + by_span.size()};
+            CHECK_FALSE(write_length(ber{}, true, len, ss));
+            CHECK_FALSE(write_length<char>(cer{}, false, len, std::back_inserter(by_char)));
+            CHECK_EQ(by_sink, by_iter);
+            CHECK_EQ(by_sink, by_func);
+            CHECK(std::equal(by_sink.begin(), by_sink.end(), by_span.data(), ss.position()));
+            CHECK(std::equal(by_sink.begin(), by_sink.end(), by_char.begin(), by_char.end(),
+                             [](std::byte a, char b){ return a == static_cast<std::byte>(b); }));
+
+            const std::byte* beg = by_sink.data();
+            CHECK_EQ(parse_length(length_options::definite_required, beg, by_sink.data() + by_sink.size()), len);
+            CHECK_EQ(beg, by_sink.data() + by_sink.size());
         }
+
+        std::vector<std::byte> output;
+        CHECK(write_length(cer{}, true, 5u, vector_sink{output}));
+        CHECK_EQ(output, to_bytes({0x80u}));
+    }
+
+    static_assert(encoded_length_size(127u) == 1);
+    static_assert(encoded_length_size(128u) == 2);
+    static_assert(encoded_length_size(0x10000u) == 4);
+
+    TEST_CASE("write_length failures") {
+        std::vector<std::byte> output;
+        CHECK_THROWS_AS(write_length(5u, length_options::indefinite_optional, vector_sink{output}), exception);
     }
 
 } /* namespace dabers */
\ No newline at end of file
@@ -0,0 +1,231 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/mapped_file.h"
+#include "exception.h"
+
+#include <doctest/doctest.h>
+#include <fmt/format.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dabers {
+
+#ifdef _WIN32
+
+    mapped_file::mapped_file(const std::filesystem::path& path, const access_pattern pattern) {
+        const DWORD flags = pattern == access_pattern::sequential ? FILE_FLAG_SEQUENTIAL_SCAN :
+                            pattern == access_pattern::random ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL;
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw_ex("Failed to open '{}' (error {}).", path.string(), GetLastError());
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            auto err = GetLastError();
+            CloseHandle(file);
+            throw_ex("Failed to get the size of '{}' (error {}).", path.string(), err);
+        }
+        m_file = file;
+        m_size = static_cast<uint64_t>(size.QuadPart);
+        if (m_size == 0) {
+            return;
+        }
+        else if (m_size > SIZE_MAX) {
+            close();
+            throw_ex("'{}' is too big to map ({} bytes).", path.string(), static_cast<uint64_t>(size.QuadPart));
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            auto err = GetLastError();
+            close();
+            throw_ex("Failed to map '{}' (error {}).", path.string(), err);
+        }
+        m_mapping = mapping;
+        m_data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_data == nullptr) {
+            auto err = GetLastError();
+            close();
+            throw_ex("Failed to map '{}' (error {}).", path.string(), err);
+        }
+    }
+
+    void mapped_file::advise(access_pattern) const noexcept {
+        //Windows only takes access hints when the file is opened.
+    }
+
+    void mapped_file::close() noexcept {
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file) {
+            CloseHandle(m_file);
+        }
+        m_data = nullptr;
+        m_mapping = nullptr;
+        m_file = nullptr;
+        m_size = 0;
+    }
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept :
+            m_data{std::exchange(other.m_data, nullptr)},
+            m_size{std::exchange(other.m_size, 0)},
+            m_file{std::exchange(other.m_file, nullptr)},
+            m_mapping{std::exchange(other.m_mapping, nullptr)} {}
+
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+        }
+        return *this;
+    }
+
+#else
+
+    mapped_file::mapped_file(const std::filesystem::path& path, const access_pattern pattern) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw_ex("Failed to open '{}': {}.", path.string(), std::strerror(errno));
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw_ex("Failed to get the size of '{}': {}.", path.string(), std::strerror(err));
+        }
+        m_size = static_cast<uint64_t>(st.st_size);
+        if (m_size > SIZE_MAX) {
+            ::close(fd);
+            m_size = 0;
+            throw_ex("'{}' is too big to map ({} bytes).", path.string(), static_cast<uint64_t>(st.st_size));
+        }
+        else if (m_size != 0) {
+            void* p = ::mmap(nullptr, static_cast<std::size_t>(m_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                const int err = errno;
+                ::close(fd);
+                m_size = 0;
+                throw_ex("Failed to map '{}': {}.", path.string(), std::strerror(err));
+            }
+            m_data = static_cast<const std::byte*>(p);
+        }
+        //The mapping keeps its own reference to the file.
+        ::close(fd);
+        advise(pattern);
+    }
+
+    void mapped_file::advise(const access_pattern pattern) const noexcept {
+        if (m_data == nullptr) {
+            return;
+        }
+        const int advice = pattern == access_pattern::sequential ? MADV_SEQUENTIAL :
+                           pattern == access_pattern::random ? MADV_RANDOM : MADV_NORMAL;
+        auto* addr = const_cast<std::byte*>(m_data);
+        ::madvise(addr, static_cast<std::size_t>(m_size), advice);
+        if (pattern == access_pattern::sequential) {
+            ::madvise(addr, static_cast<std::size_t>(m_size), MADV_WILLNEED);
+        }
+    }
+
+    void mapped_file::close() noexcept {
+        if (m_data) {
+            ::munmap(const_cast<std::byte*>(m_data), static_cast<std::size_t>(m_size));
+        }
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept :
+            m_data{std::exchange(other.m_data, nullptr)},
+            m_size{std::exchange(other.m_size, 0)} {}
+
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+#endif
+
+    mapped_file::~mapped_file() {
+        close();
+    }
+
+    TEST_CASE("mapped_file") {
+        //A name of its own so concurrent runs don't share the file, removed however the test ends.
+        std::random_device rd;
+        const auto path = std::filesystem::temp_directory_path() / fmt::format("dabers_mapped_file_test_{:08x}{:08x}.ber", rd(), rd());
+        struct remove_file {
+            const std::filesystem::path& path;
+            ~remove_file() {
+                std::error_code ec;
+                std::filesystem::remove(path, ec);
+            }
+        } cleanup{path};
+        {
+            //Three records:  INTEGER 5, SEQUENCE (indefinite) { NULL }, OCTET STRING "abc"
+            const unsigned char bytes[] = {0x02u, 0x01u, 0x05u,
+                                           0x30u, 0x80u, 0x05u, 0x00u, 0x00u, 0x00u,
+                                           0x04u, 0x03u, 0x61u, 0x62u, 0x63u};
+            std::ofstream out{path, std::ios::binary};
+            out.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+        }
+
+        mapped_file f{path};
+        CHECK_EQ(f.size(), 14u);
+        std::vector<uint64_t> numbers;
+        for (const auto& rec : f.records()) {
+            numbers.push_back(rec.id().tag_number);
+        }
+        CHECK_EQ(numbers, std::vector<uint64_t>{2, 16, 4});
+        f.advise(mapped_file::access_pattern::random);
+
+        mapped_file moved{std::move(f)};
+        CHECK(f.empty());
+        CHECK_EQ(moved.data()[0], std::byte{0x02u});
+        moved.close();
+        CHECK(moved.empty());
+        std::filesystem::remove(path);
+
+        {
+            std::ofstream out{path, std::ios::binary};
+        }
+        mapped_file empty{path};
+        CHECK(empty.empty());
+        CHECK(empty.records().begin() == empty.records().end());
+        std::filesystem::remove(path);
+
+        CHECK_THROWS_AS(mapped_file{path}, exception);
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,187 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/oid.h"
+#include "decode_detail.h"
+#include "exception.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace dabers {
+
+    namespace detail {
+        void throw_invalid_oid(const std::string_view reason) {
+            throw_ex("Invalid OBJECT IDENTIFIER: {}.", reason);
+        }
+    } /* namespace detail */
+
+    decode_error try_decode_oid(const std::span<const std::byte> contents, const std::span<uint64_t> arcs, std::size_t& count) noexcept {
+        if (contents.empty()) {
+            return decode_error::empty_oid;
+        }
+        else if ((contents.back() & std::byte{0x80u}) != std::byte{0}) {
+            //With the last octet known to end a subidentifier, none of the loops below can run off the end.
+            return decode_error::truncated_oid;
+        }
+        const std::byte* p = contents.data();
+        const std::byte* const end = p + contents.size();
+        std::size_t n = 0;
+        while (p != end) {
+            uint64_t v = 0;
+            if ((*p & std::byte{0x80u}) == std::byte{0}) {
+                //Most arcs are a single octet.
+                v = std::to_integer<uint64_t>(*p++);
+            }
+            else if (*p == std::byte{0x80u}) {
+                return decode_error::oid_arc_leading_zero;
+            }
+            else if (const auto c = end - p >= static_cast<std::ptrdiff_t>(sizeof(uint64_t)) ? detail::decode_base128_8(p, v) : 0) {
+                p += c;
+            }
+            else {
+                //Near the end of the contents, or the subidentifier is 9 or more octets long.
+                std::size_t length = 0;
+                bool more = true;
+                while (more) {
+                    if (length == max_encoded_arc_size || (v >> 57) != 0) {
+                        return decode_error::oid_arc_too_long;
+                    }
+                    const auto next = *p++;
+                    more = (next & std::byte{0x80u}) != std::byte{0};
+                    v = (v << 7) | std::to_integer<uint64_t>(next & std::byte{0x7fu});
+                    ++length;
+                }
+            }
+
+            if (n == 0) {
+                //The first subidentifier holds the first two arcs (X.690 8.19.4).
+                if (arcs.size() < 2) {
+                    return decode_error::buffer_too_small;
+                }
+                const uint64_t first = v < 80 ? v / 40 : 2;
+                arcs[0] = first;
+                arcs[1] = v - first * 40;
+                n = 2;
+            }
+            else if (n == arcs.size()) {
+                return decode_error::buffer_too_small;
+            }
+            else {
+                arcs[n++] = v;
+            }
+        }
+        count = n;
+        return decode_error::none;
+    }
+
+    std::vector<uint64_t> decode_oid(const std::span<const std::byte> contents) {
+        std::vector<uint64_t> retval(contents.size() + 1);
+        std::size_t count = 0;
+        if (auto err = try_decode_oid(contents, retval, count); err != decode_error::none) {
+            throw_decode_error(err, "object identifier");
+        }
+        retval.resize(count);
+        return retval;
+    }
+
+    std::string oid_to_string(const std::span<const std::byte> contents) {
+        const auto arcs = decode_oid(contents);
+        std::string retval;
+        for (auto a : arcs) {
+            if (!retval.empty()) {
+                retval.push_back('.');
+            }
+            fmt::format_to(std::back_inserter(retval), "{}", a);
+        }
+        return retval;
+    }
+
+    TEST_CASE("decode_oid") {
+        CHECK_EQ(decode_oid(to_bytes({0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x01u, 0x0bu})),
+                 std::vector<uint64_t>{1, 2, 840, 113549, 1, 1, 11});
+        CHECK_EQ(decode_oid(to_bytes({0x00u})), std::vector<uint64_t>{0, 0});
+        CHECK_EQ(decode_oid(to_bytes({0x4fu})), std::vector<uint64_t>{1, 39});
+        CHECK_EQ(decode_oid(to_bytes({0x88u, 0x37u, 0x03u})), std::vector<uint64_t>{2, 999, 3});
+        CHECK_EQ(oid_to_string(to_bytes({0x55u, 0x04u, 0x03u})), "2.5.4.3");
+
+        //Long arcs, both through the eight octet path and near the end of the contents.
+        const auto big = to_bytes({0x2au, 0x81u, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu, 0x01u});
+        CHECK_EQ(decode_oid(big), std::vector<uint64_t>{1, 2, UINT64_MAX, 1});
+        CHECK_EQ(decode_oid(to_bytes({0x2au, 0xffu, 0xffu, 0x7fu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu, 0x05u})),
+                 std::vector<uint64_t>{1, 2, 0x1fffff, 0x1ffffffffffff, 5});
+
+        std::array<uint64_t, 4> arcs{};
+        std::size_t count = 0;
+        CHECK_EQ(try_decode_oid({}, arcs, count), decode_error::empty_oid);
+        CHECK_EQ(try_decode_oid(to_bytes({0x2au, 0x86u}), arcs, count), decode_error::truncated_oid);
+        CHECK_EQ(try_decode_oid(to_bytes({0x2au, 0x80u, 0x01u}), arcs, count), decode_error::oid_arc_leading_zero);
+        CHECK_EQ(try_decode_oid(to_bytes({0x2au, 0x82u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x00u}), arcs, count),
+                 decode_error::oid_arc_too_long);
+        CHECK_EQ(try_decode_oid(to_bytes({0x2au, 0x01u, 0x02u, 0x03u}), arcs, count), decode_error::buffer_too_small);
+        CHECK_EQ(try_decode_oid(to_bytes({0x2au, 0x01u, 0x02u}), arcs, count), decode_error::none);
+        CHECK_EQ(count, 4u);
+        CHECK_THROWS_AS(decode_oid(to_bytes({0x86u})), exception);
+    }
+
+    TEST_CASE("encode_oid") {
+        const std::vector<uint64_t> rsa{1, 2, 840, 113549, 1, 1, 11};
+        std::vector<std::byte> out;
+        write_oid(rsa, vector_sink{out});
+        CHECK_EQ(out, to_bytes({0x06u, 0x09u, 0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x01u, 0x0bu}));
+        CHECK_EQ(encoded_oid_size(rsa), 9u);
+
+        std::array<std::byte, 16> buf{};
+        const std::vector<uint64_t> joint{2, 999, 3};
+        CHECK_EQ(encode_oid(joint, buf.data()), 3u);
+        CHECK_EQ(std::vector<std::byte>(buf.begin(), buf.begin() + 3), to_bytes({0x88u, 0x37u, 0x03u}));
+
+        CHECK_THROWS_AS(encoded_oid_size(std::vector<uint64_t>{1}), exception);
+        CHECK_THROWS_AS(encoded_oid_size(std::vector<uint64_t>{3, 1}), exception);
+        CHECK_THROWS_AS(encoded_oid_size(std::vector<uint64_t>{1, 40}), exception);
+        CHECK_THROWS_AS(encoded_oid_size(std::vector<uint64_t>{2, UINT64_MAX}), exception);
+
+        //Round trips with arcs of every width.
+        std::mt19937_64 rng{5};
+        for (int i = 0; i < 1000; ++i) {
+            std::vector<uint64_t> arcs{rng() % 3, rng() % 40};
+            const auto extra = rng() % 8;
+            for (uint64_t j = 0; j < extra; ++j) {
+                arcs.push_back(rng() >> (rng() % 64));
+            }
+            std::vector<std::byte> enc(encoded_oid_size(arcs));
+            CHECK_EQ(encode_oid(arcs, enc.data()), enc.size());
+            CHECK_EQ(decode_oid(enc), arcs);
+        }
+    }
+
+    TEST_CASE("oid_registry") {
+        constexpr encoded_oid sha256_rsa{"1.2.840.113549.1.1.11"};
+        static_assert(sha256_rsa.size() == 9);
+        static_assert(standard_oids.find(sha256_rsa.bytes()) == standard_oids.index_of("sha256WithRSAEncryption"));
+        CHECK(sha256_rsa == to_bytes({0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x01u, 0x0bu}));
+        CHECK_FALSE(sha256_rsa == to_bytes({0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x01u, 0x0cu}));
+        CHECK_THROWS_AS(encoded_oid{"1..2"}, exception);
+        CHECK_THROWS_AS(encoded_oid{"1.2a"}, exception);
+        CHECK_THROWS_AS(encoded_oid{"5.1"}, exception);
+
+        for (std::size_t i = 0; i < standard_oids.size(); ++i) {
+            CHECK_EQ(standard_oids.find(standard_oids[i].oid.bytes()), i);
+            CHECK_EQ(oid_to_string(standard_oids[i].oid.bytes()), standard_oids[i].dotted);
+        }
+        CHECK_EQ(standard_oids.find(to_bytes({0x2au, 0x03u})), standard_oids.npos);
+        CHECK_EQ(standard_oids.find({}), standard_oids.npos);
+        CHECK_EQ(standard_oids.index_of("not an oid"), standard_oids.npos);
+
+        constexpr oid_registry one{{{"id-at-commonName", "2.5.4.3"}}};
+        CHECK_EQ(one.find(to_bytes({0x55u, 0x04u, 0x03u})), 0u);
+        CHECK_EQ(one.find(to_bytes({0x55u, 0x04u, 0x04u})), one.npos);
+        CHECK_THROWS_AS(oid_registry({{"a", "1.2"}, {"b", "1.2"}}), exception);
+    }
+
+} /* namespace dabers */
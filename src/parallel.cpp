@@ -0,0 +1,274 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/parallel.h"
+#include "dabers/skip.h"
+#include "dabers/tlv_view.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace dabers {
+
+    decode_error scan_records(const std::span<const std::byte> data, const rules r, std::vector<std::span<const std::byte>>& out) {
+        const std::byte* cur = data.data();
+        const std::byte* const end = data.data() + data.size();
+        while (cur != end) {
+            const std::byte* const record = cur;
+            if (auto err = skip_element(r, cur, end); err != decode_error::none) {
+                return err;
+            }
+            out.emplace_back(record, cur);
+        }
+        return decode_error::none;
+    }
+
+    namespace {
+
+        constexpr uint64_t pack_range(const uint64_t begin, const uint64_t end) noexcept {
+            return begin | (end << 32);
+        }
+
+        constexpr uint64_t range_begin(const uint64_t bounds) noexcept { return bounds & 0xffffffffu; }
+        constexpr uint64_t range_end(const uint64_t bounds) noexcept { return bounds >> 32; }
+
+        /**
+         * Batches are split into chunks of this many indices so a range always fits in 32 bits.
+         */
+        constexpr std::size_t MAX_BATCH = std::numeric_limits<uint32_t>::max();
+
+    } /* namespace */
+
+    thread_pool::thread_pool(std::size_t threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        m_ranges = std::make_unique<work_range[]>(threads);
+        m_threads.reserve(threads - 1);
+        for (std::size_t i = 1; i < threads; ++i) {
+            m_threads.emplace_back([this, i]{ worker_loop(i); });
+        }
+    }
+
+    thread_pool::~thread_pool() {
+        {
+            std::lock_guard lock{m_mutex};
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (auto& t : m_threads) {
+            t.join();
+        }
+    }
+
+    void thread_pool::run(std::size_t count, const task_fn fn, void* const ctx) {
+        std::lock_guard batch_lock{m_batch_mutex};
+        const auto workers = size();
+        std::size_t base = 0;
+        while (count > 0) {
+            const auto batch = std::min(count, MAX_BATCH);
+            for (std::size_t w = 0; w < workers; ++w) {
+                m_ranges[w].bounds.store(pack_range(batch * w / workers, batch * (w + 1) / workers), std::memory_order_relaxed);
+            }
+            {
+                std::lock_guard lock{m_mutex};
+                m_fn = fn;
+                m_ctx = ctx;
+                m_base = base;
+                m_active = m_threads.size();
+                ++m_generation;
+            }
+            m_start.notify_all();
+            work(0);
+            std::unique_lock lock{m_mutex};
+            m_done.wait(lock, [this]{ return m_active == 0; });
+            count -= batch;
+            base += batch;
+        }
+
+        std::exception_ptr err;
+        {
+            std::lock_guard lock{m_mutex};
+            err = std::exchange(m_error, nullptr);
+        }
+        if (err) {
+            std::rethrow_exception(err);
+        }
+    }
+
+    void thread_pool::work(const std::size_t worker) noexcept {
+        const auto workers = size();
+        auto& mine = m_ranges[worker].bounds;
+        while (true) {
+            auto bounds = mine.load(std::memory_order_acquire);
+            bool took = false;
+            while (range_begin(bounds) < range_end(bounds)) {
+                if (mine.compare_exchange_weak(bounds, bounds + 1, std::memory_order_acq_rel)) {
+                    took = true;
+                    break;
+                }
+            }
+            if (took) {
+                try {
+                    m_fn(m_ctx, m_base + range_begin(bounds));
+                }
+                catch (...) {
+                    std::lock_guard lock{m_mutex};
+                    if (!m_error) {
+                        m_error = std::current_exception();
+                    }
+                }
+                continue;
+            }
+
+            //Our range is empty, so take the back half of someone else's.  Nobody else
+            //  adds to an empty range, so it's safe to store the stolen work into ours.
+            bool stole = false;
+            for (std::size_t k = 1; k < workers && !stole; ++k) {
+                auto& victim = m_ranges[(worker + k) % workers].bounds;
+                auto vb = victim.load(std::memory_order_acquire);
+                while (range_begin(vb) < range_end(vb)) {
+                    const auto mid = range_begin(vb) + (range_end(vb) - range_begin(vb)) / 2;
+                    if (victim.compare_exchange_weak(vb, pack_range(range_begin(vb), mid), std::memory_order_acq_rel)) {
+                        mine.store(pack_range(mid, range_end(vb)), std::memory_order_release);
+                        stole = true;
+                        break;
+                    }
+                }
+            }
+            if (!stole) {
+                return;
+            }
+        }
+    }
+
+    void thread_pool::worker_loop(const std::size_t worker) {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock lock{m_mutex};
+                m_start.wait(lock, [&]{ return m_stop || m_generation != seen; });
+                if (m_stop) {
+                    return;
+                }
+                seen = m_generation;
+            }
+            work(worker);
+            {
+                std::lock_guard lock{m_mutex};
+                --m_active;
+            }
+            m_done.notify_one();
+        }
+    }
+
+    namespace {
+
+        /**
+         * A run of SEQUENCE records, each holding an INTEGER with its index and a varying
+         * amount of padding.  Every fifth one uses the indefinite form.
+         */
+        std::vector<std::byte> make_records(const unsigned int count) {
+            std::vector<unsigned int> data;
+            for (unsigned int i = 0; i < count; ++i) {
+                const auto pad = i % 7;
+                if (i % 5 == 0) {
+                    data.insert(data.end(), {0x30u, 0x80u, 0x02u, 0x02u, (i >> 8) & 0xffu, i & 0xffu, 0x04u, pad});
+                    data.insert(data.end(), pad, 0xaau);
+                    data.insert(data.end(), {0x00u, 0x00u});
+                }
+                else {
+                    data.insert(data.end(), {0x30u, 6u + pad, 0x02u, 0x02u, (i >> 8) & 0xffu, i & 0xffu, 0x04u, pad});
+                    data.insert(data.end(), pad, 0xaau);
+                }
+            }
+            return to_bytes(data);
+        }
+
+        unsigned int record_number(std::span<const std::byte> record) {
+            tlv_view outer{record};
+            auto seq = *outer.begin();
+            auto num = *seq.children().begin();
+            return (std::to_integer<unsigned int>(num.contents()[0]) << 8) | std::to_integer<unsigned int>(num.contents()[1]);
+        }
+
+    } /* namespace */
+
+    TEST_CASE("scan_records") {
+        auto data = make_records(20);
+        std::vector<std::span<const std::byte>> records;
+        REQUIRE_EQ(scan_records(data, rules::ber, records), decode_error::none);
+        REQUIRE_EQ(records.size(), 20);
+        CHECK_EQ(records.front().data(), data.data());
+        CHECK_EQ(records.back().data() + records.back().size(), data.data() + data.size());
+        for (unsigned int i = 0; i < records.size(); ++i) {
+            CHECK_EQ(record_number(records[i]), i);
+        }
+
+        records.clear();
+        CHECK_EQ(scan_records(data, rules::der, records), decode_error::indefinite_length_forbidden);
+        CHECK(records.empty());
+
+        records.clear();
+        data.pop_back();
+        CHECK_EQ(scan_records(data, rules::ber, records), decode_error::buffer_too_small);
+        CHECK_EQ(records.size(), 19);
+    }
+
+    TEST_CASE("thread_pool") {
+        for (std::size_t threads : {1u, 2u, 4u}) {
+            thread_pool pool{threads};
+            CHECK_EQ(pool.size(), threads);
+            std::vector<std::atomic<int>> hits(10000);
+            pool.for_each_index(hits.size(), [&](std::size_t i){ hits[i].fetch_add(1, std::memory_order_relaxed); });
+            CHECK(std::all_of(hits.begin(), hits.end(), [](const auto& h){ return h.load() == 1; }));
+
+            pool.for_each_index(0, [](std::size_t){ FAIL("Nothing to do"); });
+
+            std::atomic<int> calls{0};
+            CHECK_THROWS_AS(pool.for_each_index(100, [&](std::size_t i){
+                calls.fetch_add(1);
+                if (i == 42) {
+                    throw std::runtime_error{"bad record"};
+                }
+            }), std::runtime_error);
+            CHECK_EQ(calls.load(), 100);
+        }
+    }
+
+    TEST_CASE("parallel_decode") {
+        auto data = make_records(1000);
+        std::vector<std::span<const std::byte>> records;
+        REQUIRE_EQ(scan_records(data, rules::ber, records), decode_error::none);
+        thread_pool pool{4};
+        auto decode = [](std::size_t, std::span<const std::byte> rec){ return record_number(rec); };
+
+        auto results = parallel_decode(pool, records, decode);
+        REQUIRE_EQ(results.size(), records.size());
+        std::vector<unsigned int> expected(records.size());
+        std::iota(expected.begin(), expected.end(), 0u);
+        CHECK_EQ(results, expected);
+
+        std::vector<unsigned int> ordered;
+        parallel_decode(pool, records, decode, [&](std::size_t i, unsigned int n){
+            CHECK_EQ(i, ordered.size());
+            ordered.push_back(n);
+        });
+        CHECK_EQ(ordered, expected);
+
+        std::vector<unsigned int> unordered;
+        parallel_decode(pool, records, decode, [&](std::size_t i, unsigned int n){
+            CHECK_EQ(i, n);
+            unordered.push_back(n);
+        }, result_order::unordered);
+        std::sort(unordered.begin(), unordered.end());
+        CHECK_EQ(unordered, expected);
+    }
+
+} /* namespace dabers */
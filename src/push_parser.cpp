@@ -0,0 +1,288 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/push_parser.h"
+#include "dabers/codec.h"
+#include "decode_detail.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+namespace dabers {
+
+    namespace {
+
+        /**
+         * Like try_parse_header, but doesn't need the contents to be in the buffer.
+         */
+        decode_error decode_header_only(const std::array<length_options, 2>& opts, const std::byte*& cur, const std::byte* const end,
+                                        tlv_header& out) noexcept {
+            const std::byte* p = cur;
+            if (auto err = detail::decode_tag<true>(p, end, out.id); err != decode_error::none) {
+                return err;
+            }
+            else if (p == end) {
+                return decode_error::buffer_too_small;
+            }
+            else if (auto err = detail::decode_length<true>(opts[out.id.constructed], p, end, out.length);
+                    err != decode_error::none) {
+                return err;
+            }
+            out.header_size = static_cast<std::size_t>(p - cur);
+            out.contents = {};
+            cur = p;
+            return decode_error::none;
+        }
+
+    }
+
+    static_assert(detail::max_decoded_header_size == 20, "push_parser::MAX_HEADER_SIZE must match the decoder.");
+
+    push_parser::push_parser(const rules r) noexcept :
+            m_length_options{with_codec(r, [](auto c) {
+                return std::array{c.decode_length_options(false), c.decode_length_options(true)};
+            })} {}
+
+    decode_error push_parser::next(std::span<const std::byte>& chunk, push_event& out) noexcept {
+        if (m_error != decode_error::none) {
+            return m_error;
+        }
+
+        //Close any definite length constructed elements that are complete.
+        if (!m_in_content && !m_open.empty() && m_open.back().end == m_offset) {
+            if (m_open.back().indefinite) {
+                //An indefinite length element without its end-of-contents octets.
+                return fail(decode_error::buffer_too_small);
+            }
+            m_open.pop_back();
+            out.type = push_event::kind::end;
+            out.depth = m_open.size();
+            return decode_error::none;
+        }
+
+        if (m_in_content) {
+            if (m_content_remaining == 0) {
+                m_in_content = false;
+                out.type = push_event::kind::end;
+                out.depth = m_open.size();
+                return decode_error::none;
+            }
+            else if (chunk.empty()) {
+                out.type = push_event::kind::need_more;
+                return decode_error::none;
+            }
+            const auto n = static_cast<std::size_t>(std::min<uint64_t>(m_content_remaining, chunk.size()));
+            out.type = push_event::kind::content;
+            out.content = chunk.first(n);
+            chunk = chunk.subspan(n);
+            m_content_remaining -= n;
+            m_offset += n;
+            return decode_error::none;
+        }
+
+        if (chunk.empty()) {
+            out.type = push_event::kind::need_more;
+            return decode_error::none;
+        }
+
+        //Decode straight from the chunk when we can, otherwise from the bytes we've kept.
+        const std::byte* begin = chunk.data();
+        const std::byte* end = chunk.data() + chunk.size();
+        const std::size_t old_pending = m_pending_size;
+        std::size_t copied = 0;
+        if (old_pending != 0) {
+            copied = std::min(m_pending.size() - old_pending, chunk.size());
+            std::memcpy(m_pending.data() + old_pending, chunk.data(), copied);
+            begin = m_pending.data();
+            end = m_pending.data() + old_pending + copied;
+        }
+
+        const std::byte* cur = begin;
+        tlv_header& h = out.header;
+        if (auto err = decode_header_only(m_length_options, cur, end, h); err == decode_error::buffer_too_small) {
+            if (old_pending == 0) {
+                std::memcpy(m_pending.data(), chunk.data(), chunk.size());
+                m_pending_size = chunk.size();
+            }
+            else {
+                m_pending_size += copied;
+            }
+            chunk = {};
+            out.type = push_event::kind::need_more;
+            return decode_error::none;
+        }
+        else if (err != decode_error::none) {
+            return fail(err);
+        }
+
+        chunk = chunk.subspan(h.header_size - old_pending);
+        m_pending_size = 0;
+        const uint64_t limit = m_open.empty() ? INDEFINITE : m_open.back().end;
+        const uint64_t start = m_offset;
+        m_offset += h.header_size;
+
+        if (limit != INDEFINITE && (m_offset > limit || (h.length && *h.length > limit - m_offset))) {
+            m_offset = start;
+            return fail(decode_error::buffer_too_small);
+        }
+        else if (h.id == tag{tag_class_type::universal, false, 0} && h.length == 0u) {
+            if (m_open.empty() || !m_open.back().indefinite) {
+                m_offset = start;
+                return fail(decode_error::unexpected_end_of_contents);
+            }
+            m_open.pop_back();
+            out.type = push_event::kind::end;
+            out.depth = m_open.size();
+            return decode_error::none;
+        }
+        else if (h.id.constructed && m_open.size() == max_push_depth) {
+            m_offset = start;
+            return fail(decode_error::nesting_too_deep);
+        }
+
+        out.type = push_event::kind::element;
+        out.depth = m_open.size();
+        if (h.id.constructed) {
+            m_open.push_back({h.length ? m_offset + *h.length : limit, !h.length});
+        }
+        else {
+            m_in_content = true;
+            m_content_remaining = *h.length;
+        }
+        return decode_error::none;
+    }
+
+    decode_error push_parser::finish() const noexcept {
+        if (m_error != decode_error::none) {
+            return m_error;
+        }
+        else if (m_in_content || m_pending_size != 0 || !m_open.empty()) {
+            return decode_error::buffer_too_small;
+        }
+        return decode_error::none;
+    }
+
+    void push_parser::reset() noexcept {
+        m_error = decode_error::none;
+        m_in_content = false;
+        m_offset = 0;
+        m_content_remaining = 0;
+        m_open.clear();
+        m_pending_size = 0;
+    }
+
+    namespace {
+
+        struct recording_handler {
+            std::string log;
+
+            void on_element(const tlv_header& h, std::size_t depth) {
+                if (h.length) {
+                    fmt::format_to(std::back_inserter(log), "E{}:{}/{} ", depth, h.id.tag_number, *h.length);
+                }
+                else {
+                    fmt::format_to(std::back_inserter(log), "E{}:{}/i ", depth, h.id.tag_number);
+                }
+            }
+
+            void on_content(std::span<const std::byte> data) {
+                for (auto b : data) {
+                    log += static_cast<char>(b);
+                }
+            }
+
+            void on_end(std::size_t depth) {
+                fmt::format_to(std::back_inserter(log), " X{} ", depth);
+            }
+        };
+
+    }
+
+    TEST_CASE("push_parser chunking") {
+        //SEQUENCE { OCTET STRING "abc", [1000] (indefinite) { NULL, [0] { } } } UTF8String "xy"
+        auto buf = to_bytes({0x30u, 0x0fu,
+                                 0x04u, 0x03u, 0x61u, 0x62u, 0x63u,
+                                 0xbfu, 0x87u, 0x68u, 0x80u,
+                                     0x05u, 0x00u,
+                                     0xa0u, 0x00u,
+                                 0x00u, 0x00u,
+                             0x0cu, 0x02u, 0x78u, 0x79u});
+        const std::string expected = "E0:16/15 E1:4/3 abc X1 E1:1000/i E2:5/0  X2 E2:0/0  X2  X1  X0 E0:12/2 xy X0 ";
+
+        for (std::size_t chunk_size = 1; chunk_size <= buf.size(); ++chunk_size) {
+            push_parser p;
+            recording_handler h;
+            for (std::size_t i = 0; i < buf.size(); i += chunk_size) {
+                const auto n = std::min(chunk_size, buf.size() - i);
+                REQUIRE_EQ(p.feed(std::span{buf}.subspan(i, n), h), decode_error::none);
+            }
+            CHECK_EQ(h.log, expected);
+            CHECK_EQ(p.finish(), decode_error::none);
+            CHECK_EQ(p.offset(), buf.size());
+        }
+    }
+
+    TEST_CASE("push_parser failures") {
+        push_parser p;
+        recording_handler h;
+        //Incomplete input.
+        auto buf = to_bytes({0x30u, 0x80u, 0x02u, 0x01u});
+        CHECK_EQ(p.feed(buf, h), decode_error::none);
+        CHECK_EQ(p.finish(), decode_error::buffer_too_small);
+
+        //Child longer than its parent.
+        p.reset();
+        buf = to_bytes({0x30u, 0x03u, 0x02u, 0x02u, 0x05u, 0x06u});
+        CHECK_EQ(p.feed(buf, h), decode_error::buffer_too_small);
+        CHECK_EQ(p.finish(), decode_error::buffer_too_small);
+
+        //Malformed tag, split across chunks; the error is sticky.
+        p.reset();
+        buf = to_bytes({0x1fu, 0x80u});
+        CHECK_EQ(p.feed(std::span{buf}.first(1), h), decode_error::none);
+        CHECK_EQ(p.feed(std::span{buf}.subspan(1), h), decode_error::tag_number_leading_zero);
+        CHECK_EQ(p.feed(std::span{buf}, h), decode_error::tag_number_leading_zero);
+
+        //An indefinite length child running past the end of its definite length parent.
+        p.reset();
+        buf = to_bytes({0x30u, 0x04u, 0x30u, 0x80u, 0x04u, 0x10u});
+        buf.resize(buf.size() + 18);
+        CHECK_EQ(p.feed(buf, h), decode_error::buffer_too_small);
+        CHECK_EQ(p.offset(), 4u);
+
+        //A definite length parent ending while its indefinite length child is still open.
+        p.reset();
+        buf = to_bytes({0x30u, 0x02u, 0x30u, 0x80u, 0x05u, 0x00u});
+        CHECK_EQ(p.feed(buf, h), decode_error::buffer_too_small);
+        CHECK_EQ(p.offset(), 4u);
+
+        //End-of-contents octets outside an indefinite length element.
+        for (const auto& eoc : {to_bytes({0x30u, 0x02u, 0x00u, 0x00u}), to_bytes({0x00u, 0x00u})}) {
+            p.reset();
+            CHECK_EQ(p.feed(eoc, h), decode_error::unexpected_end_of_contents);
+        }
+
+        //Too many levels of nesting.
+        p.reset();
+        buf.clear();
+        for (std::size_t i = 0; i <= max_push_depth; ++i) {
+            buf.push_back(std::byte{0x30u});
+            buf.push_back(std::byte{0x80u});
+        }
+        CHECK_EQ(p.feed(buf, h), decode_error::nesting_too_deep);
+        CHECK_EQ(p.depth(), max_push_depth);
+
+        //DER doesn't allow the indefinite form.
+        push_parser d{rules::der};
+        buf = to_bytes({0x30u, 0x80u});
+        CHECK_EQ(d.feed(buf, h), decode_error::indefinite_length_forbidden);
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,93 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_SIMD_DETAIL_H
+#define DABERS_SIMD_DETAIL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Thin wrappers over the vector instructions the string kernels use, so each kernel is
+ * written once as a template and instantiated for every width the target supports.  Like
+ * the BMI2 paths in decode_detail.h these are chosen at compile time, so build with e.g.
+ * -mavx2 or -march=native to get the wider kernels.
+ */
+namespace dabers::detail {
+
+#if defined(__SSE2__)
+    struct sse2_ops {
+        using vec = __m128i;
+        static constexpr std::size_t width = 16;
+
+        static vec load(const std::byte* const p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(std::byte* const p, const vec v) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static vec splat(const uint8_t b) noexcept { return _mm_set1_epi8(static_cast<char>(b)); }
+        static vec zero() noexcept { return _mm_setzero_si128(); }
+        static vec and_(const vec a, const vec b) noexcept { return _mm_and_si128(a, b); }
+        static vec or_(const vec a, const vec b) noexcept { return _mm_or_si128(a, b); }
+        static vec xor_(const vec a, const vec b) noexcept { return _mm_xor_si128(a, b); }
+        static vec sub(const vec a, const vec b) noexcept { return _mm_sub_epi8(a, b); }
+        static vec subs(const vec a, const vec b) noexcept { return _mm_subs_epu8(a, b); }
+        static vec eq(const vec a, const vec b) noexcept { return _mm_cmpeq_epi8(a, b); }
+        static uint32_t high_bits(const vec v) noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+        static bool any(const vec v) noexcept { return high_bits(eq(v, zero())) != 0xffffu; }
+    };
+#endif
+
+#if defined(__SSSE3__)
+    struct ssse3_ops : sse2_ops {
+        static vec table(const std::array<uint8_t, 16>& t) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.data())); }
+        /**
+         * t[i] for each byte i, which must be less than 16 (or have its top bit set for 0).
+         */
+        static vec lookup16(const vec t, const vec i) noexcept { return _mm_shuffle_epi8(t, i); }
+        static vec high_nibbles(const vec v) noexcept { return _mm_and_si128(_mm_srli_epi16(v, 4), splat(0x0fu)); }
+        /**
+         * The input shifted by N bytes, with the last N bytes of the previous block shifted in.
+         */
+        template <int N>
+        static vec prev(const vec cur, const vec previous) noexcept { return _mm_alignr_epi8(cur, previous, 16 - N); }
+    };
+#endif
+
+#if defined(__AVX2__)
+    struct avx2_ops {
+        using vec = __m256i;
+        static constexpr std::size_t width = 32;
+
+        static vec load(const std::byte* const p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(std::byte* const p, const vec v) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static vec splat(const uint8_t b) noexcept { return _mm256_set1_epi8(static_cast<char>(b)); }
+        static vec zero() noexcept { return _mm256_setzero_si256(); }
+        static vec and_(const vec a, const vec b) noexcept { return _mm256_and_si256(a, b); }
+        static vec or_(const vec a, const vec b) noexcept { return _mm256_or_si256(a, b); }
+        static vec xor_(const vec a, const vec b) noexcept { return _mm256_xor_si256(a, b); }
+        static vec sub(const vec a, const vec b) noexcept { return _mm256_sub_epi8(a, b); }
+        static vec subs(const vec a, const vec b) noexcept { return _mm256_subs_epu8(a, b); }
+        static vec eq(const vec a, const vec b) noexcept { return _mm256_cmpeq_epi8(a, b); }
+        static uint32_t high_bits(const vec v) noexcept { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); }
+        static bool any(const vec v) noexcept { return _mm256_testz_si256(v, v) == 0; }
+
+        static vec table(const std::array<uint8_t, 16>& t) noexcept {
+            return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.data())));
+        }
+        static vec lookup16(const vec t, const vec i) noexcept { return _mm256_shuffle_epi8(t, i); }
+        static vec high_nibbles(const vec v) noexcept { return _mm256_and_si256(_mm256_srli_epi16(v, 4), splat(0x0fu)); }
+        template <int N>
+        static vec prev(const vec cur, const vec previous) noexcept {
+            //alignr works within 128 bit lanes, so first line up the lane before each lane of cur.
+            return _mm256_alignr_epi8(cur, _mm256_permute2x128_si256(previous, cur, 0x21), 16 - N);
+        }
+    };
+#endif
+
+} /* namespace dabers::detail */
+
+#endif //DABERS_SIMD_DETAIL_H
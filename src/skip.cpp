@@ -0,0 +1,210 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/skip.h"
+#include "dabers/codec.h"
+#include "dabers/header.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <random>
+#include <vector>
+
+namespace dabers {
+
+    namespace {
+
+        template <typename Rules>
+        decode_error find_eoc(const std::byte* cur, const std::byte* const end, const std::byte*& eoc) noexcept {
+            //Whether a constructed element with a one octet length is allowed here.
+            constexpr bool definite_constructed = length_options_for(Rules{}, true) != length_options::indefinite_required;
+            std::size_t depth = 1;
+            tlv_header h;
+            while (true) {
+                if (end - cur < 2) {
+                    return decode_error::buffer_too_small;
+                }
+                const auto id = std::to_integer<unsigned int>(cur[0]);
+                const auto len = std::to_integer<unsigned int>(cur[1]);
+                if (id == 0 && len == 0) {
+                    if (--depth == 0) {
+                        eoc = cur;
+                        return decode_error::none;
+                    }
+                    cur += 2;
+                }
+                else if ((id & 0x1fu) != 0x1fu && len < 0x80u && (definite_constructed || (id & 0x20u) == 0)) {
+                    //A low tag number and a short form length, which is almost everything.
+                    if (static_cast<std::size_t>(end - cur) - 2 < len) {
+                        return decode_error::buffer_too_small;
+                    }
+                    cur += 2 + len;
+                }
+                else if (auto err = dabers::try_parse_header(Rules{}, cur, end, h); err != decode_error::none) {
+                    return err;
+                }
+                else if (h.indefinite()) {
+                    ++depth;
+                }
+                else {
+                    cur += h.contents.size();
+                }
+            }
+        }
+
+        template <typename Rules>
+        decode_error skip(const std::byte*& begin, const std::byte* const end) noexcept {
+            const std::byte* cur = begin;
+            tlv_header h;
+            if (auto err = dabers::try_parse_header(Rules{}, cur, end, h); err != decode_error::none) {
+                return err;
+            }
+            else if (!h.indefinite()) {
+                begin = cur + h.contents.size();
+                return decode_error::none;
+            }
+            else if constexpr (!std::same_as<Rules, der>) {
+                const std::byte* eoc = nullptr;
+                if (auto err = find_eoc<Rules>(cur, end, eoc); err != decode_error::none) {
+                    return err;
+                }
+                begin = eoc + 2;
+                return decode_error::none;
+            }
+            return decode_error::indefinite_length_forbidden;
+        }
+
+        decode_error test_skip(rules r, const std::vector<unsigned int>& v, std::size_t& skipped) {
+            auto b = to_bytes(v);
+            const std::byte* beg = b.data();
+            auto err = skip_element(r, beg, b.data() + b.size());
+            skipped = static_cast<std::size_t>(beg - b.data());
+            return err;
+        }
+
+    }
+
+    decode_error skip_element(ber, const std::byte*& begin, const std::byte* const end) noexcept {
+        return skip<ber>(begin, end);
+    }
+
+    decode_error skip_element(cer, const std::byte*& begin, const std::byte* const end) noexcept {
+        return skip<cer>(begin, end);
+    }
+
+    decode_error skip_element(der, const std::byte*& begin, const std::byte* const end) noexcept {
+        return skip<der>(begin, end);
+    }
+
+    decode_error skip_element(const rules r, const std::byte*& begin, const std::byte* const end) noexcept {
+        return with_codec(r, [&](auto c){ return skip<typename decltype(c)::rules_type>(begin, end); });
+    }
+
+    decode_error find_end_of_contents(ber, const std::byte* const contents, const std::byte* const end, const std::byte*& eoc) noexcept {
+        return find_eoc<ber>(contents, end, eoc);
+    }
+
+    decode_error find_end_of_contents(cer, const std::byte* const contents, const std::byte* const end, const std::byte*& eoc) noexcept {
+        return find_eoc<cer>(contents, end, eoc);
+    }
+
+    decode_error find_end_of_contents(const rules r, const std::byte* const contents, const std::byte* const end, const std::byte*& eoc) noexcept {
+        return with_codec(r, [&](auto c){ return c.find_end_of_contents(contents, end, eoc); });
+    }
+
+    TEST_CASE("skip_element") {
+        std::size_t skipped = 0;
+        CHECK_EQ(test_skip(rules::der, {0x02u, 0x01u, 0x05u, 0xffu}, skipped), decode_error::none);
+        CHECK_EQ(skipped, 3u);
+        CHECK_EQ(test_skip(rules::der, {0x30u, 0x03u, 0x02u, 0x01u, 0x05u, 0xffu}, skipped), decode_error::none);
+        CHECK_EQ(skipped, 5u);
+
+        //Nested indefinite lengths, with 00 00 inside primitive and definite length contents
+        //  which mustn't be mistaken for end-of-contents octets.
+        const std::vector<unsigned int> nested{0x30u, 0x80u,
+                                                  0x04u, 0x02u, 0x00u, 0x00u,
+                                                  0xa0u, 0x80u,
+                                                      0x30u, 0x04u, 0x04u, 0x02u, 0x00u, 0x00u,
+                                                      0x1fu, 0x81u, 0x00u, 0x81u, 0x02u, 0x00u, 0x00u,
+                                                  0x00u, 0x00u,
+                                              0x00u, 0x00u,
+                                              0x05u, 0x00u};
+        CHECK_EQ(test_skip(rules::ber, nested, skipped), decode_error::none);
+        CHECK_EQ(skipped, nested.size() - 2);
+        CHECK_EQ(test_skip(rules::der, nested, skipped), decode_error::indefinite_length_forbidden);
+        CHECK_EQ(skipped, 0u);
+        //CER doesn't allow the definite length SEQUENCE inside.
+        CHECK_EQ(test_skip(rules::cer, nested, skipped), decode_error::indefinite_length_required);
+        CHECK_EQ(skipped, 0u);
+
+        CHECK_EQ(test_skip(rules::ber, {0x30u, 0x80u, 0x04u, 0x01u, 0x00u, 0x00u}, skipped), decode_error::buffer_too_small);
+        CHECK_EQ(test_skip(rules::ber, {0x30u, 0x80u, 0x04u, 0x05u, 0x00u, 0x00u}, skipped), decode_error::buffer_too_small);
+        CHECK_EQ(test_skip(rules::ber, {0x30u, 0x80u, 0x24u, 0x80u, 0x00u, 0x00u}, skipped), decode_error::buffer_too_small);
+        CHECK_EQ(test_skip(rules::ber, {0x30u, 0x80u, 0x1fu, 0x80u, 0x01u, 0x00u, 0x00u, 0x00u}, skipped), decode_error::tag_number_leading_zero);
+        CHECK_EQ(skipped, 0u);
+    }
+
+    TEST_CASE("find_end_of_contents") {
+        //The contents of SEQUENCE (indefinite) { [0] (indefinite) { }, OCTET STRING 00 00 }
+        const auto buf = to_bytes({0xa0u, 0x80u, 0x00u, 0x00u, 0x04u, 0x02u, 0x00u, 0x00u, 0x00u, 0x00u, 0x05u, 0x00u});
+        const std::byte* const end = buf.data() + buf.size();
+        for (auto r : {rules::ber, rules::cer}) {
+            const std::byte* eoc = nullptr;
+            CHECK_EQ(find_end_of_contents(r, buf.data(), end, eoc), decode_error::none);
+            CHECK_EQ(eoc, buf.data() + 8);
+            CHECK_EQ(find_end_of_contents(r, buf.data(), buf.data() + 8, eoc), decode_error::buffer_too_small);
+        }
+        const std::byte* eoc = nullptr;
+        CHECK_EQ(find_end_of_contents(rules::der, buf.data(), end, eoc), decode_error::indefinite_length_forbidden);
+    }
+
+    TEST_CASE("skip_element matches header walk") {
+        //Random trees of indefinite and definite elements, checked against a walk that
+        //  parses every header.
+        std::mt19937_64 rng{5};
+        auto build = [&](auto& self, std::vector<std::byte>& out, int depth) -> void {
+            const auto pick = rng() % 4;
+            if (depth > 4 || pick == 0) {
+                const auto len = rng() % 300;
+                write_tag(tag{tag_class_type::context_specific, false, rng() % 40}, vector_sink{out});
+                write_length(len, length_options::definite_required, vector_sink{out});
+                out.resize(out.size() + len, rng() % 2 ? std::byte{0} : std::byte{0x55u});
+                return;
+            }
+            std::vector<std::byte> contents;
+            for (auto n = rng() % 4; n > 0; --n) {
+                self(self, contents, depth + 1);
+            }
+            write_tag(tag{tag_class_type::universal, true, 16}, vector_sink{out});
+            if (pick == 1) {
+                write_length(contents.size(), length_options::definite_required, vector_sink{out});
+                out.insert(out.end(), contents.begin(), contents.end());
+            }
+            else {
+                out.push_back(std::byte{0x80u});
+                out.insert(out.end(), contents.begin(), contents.end());
+                out.push_back(std::byte{0});
+                out.push_back(std::byte{0});
+            }
+        };
+        for (int i = 0; i < 200; ++i) {
+            std::vector<std::byte> buf;
+            build(build, buf, 0);
+            const auto size = buf.size();
+            buf.push_back(std::byte{0x05u});
+            buf.push_back(std::byte{0x00u});
+            const std::byte* beg = buf.data();
+            REQUIRE_EQ(skip_element(ber{}, beg, buf.data() + buf.size()), decode_error::none);
+            CHECK_EQ(beg, buf.data() + size);
+
+            //Cutting the buffer anywhere inside the element has to fail without moving.
+            const auto cut = 1 + rng() % (size - 1);
+            beg = buf.data();
+            CHECK_NE(skip_element(ber{}, beg, buf.data() + cut), decode_error::none);
+            CHECK_EQ(beg, buf.data());
+        }
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,498 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/character_string.h"
+#include "dabers/integer.h"
+#include "decode_detail.h"
+#include "exception.h"
+#include "simd_detail.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace dabers {
+
+    namespace {
+
+        constexpr uint32_t MAX_CODE_POINT = 0x10ffffu;
+
+        constexpr bool is_surrogate(const uint32_t cp) noexcept {
+            return cp >= 0xd800u && cp <= 0xdfffu;
+        }
+
+        constexpr std::ptrdiff_t utf8_size(const uint32_t cp) noexcept {
+            return cp < 0x80u ? 1 : cp < 0x800u ? 2 : cp < 0x10000u ? 3 : 4;
+        }
+
+        char* put_utf8(const uint32_t cp, char* const o) noexcept {
+            if (cp < 0x80u) {
+                o[0] = static_cast<char>(cp);
+                return o + 1;
+            }
+            else if (cp < 0x800u) {
+                o[0] = static_cast<char>(0xc0u | (cp >> 6));
+                o[1] = static_cast<char>(0x80u | (cp & 0x3fu));
+                return o + 2;
+            }
+            else if (cp < 0x10000u) {
+                o[0] = static_cast<char>(0xe0u | (cp >> 12));
+                o[1] = static_cast<char>(0x80u | ((cp >> 6) & 0x3fu));
+                o[2] = static_cast<char>(0x80u | (cp & 0x3fu));
+                return o + 3;
+            }
+            o[0] = static_cast<char>(0xf0u | (cp >> 18));
+            o[1] = static_cast<char>(0x80u | ((cp >> 12) & 0x3fu));
+            o[2] = static_cast<char>(0x80u | ((cp >> 6) & 0x3fu));
+            o[3] = static_cast<char>(0x80u | (cp & 0x3fu));
+            return o + 4;
+        }
+
+        /**
+         * Decodes one UTF-8 character, rejecting overlong forms, surrogates and anything
+         * over U+10FFFF.
+         * @return The number of octets, or 0 if they aren't valid UTF-8.
+         */
+        std::ptrdiff_t get_utf8(const std::byte* const p, const std::byte* const end, uint32_t& cp) noexcept {
+            const auto c = std::to_integer<uint32_t>(*p);
+            if (c < 0x80u) {
+                cp = c;
+                return 1;
+            }
+            std::ptrdiff_t n = 0;
+            uint32_t lo = 0x80u;
+            uint32_t hi = 0xbfu;
+            if (c < 0xc2u) {
+                return 0;
+            }
+            else if (c < 0xe0u) {
+                n = 2;
+                cp = c & 0x1fu;
+            }
+            else if (c < 0xf0u) {
+                n = 3;
+                cp = c & 0x0fu;
+                lo = c == 0xe0u ? 0xa0u : lo;
+                hi = c == 0xedu ? 0x9fu : hi;
+            }
+            else if (c < 0xf5u) {
+                n = 4;
+                cp = c & 0x07u;
+                lo = c == 0xf0u ? 0x90u : lo;
+                hi = c == 0xf4u ? 0x8fu : hi;
+            }
+            else {
+                return 0;
+            }
+            if (end - p < n) {
+                return 0;
+            }
+            const auto second = std::to_integer<uint32_t>(p[1]);
+            if (second < lo || second > hi) {
+                return 0;
+            }
+            cp = (cp << 6) | (second & 0x3fu);
+            for (std::ptrdiff_t i = 2; i < n; ++i) {
+                const auto d = std::to_integer<uint32_t>(p[i]);
+                if ((d & 0xc0u) != 0x80u) {
+                    return 0;
+                }
+                cp = (cp << 6) | (d & 0x3fu);
+            }
+            return n;
+        }
+
+#if defined(__SSE2__)
+        /*
+         * The vector steps look at a block and convert every character in it as if it
+         * were ASCII, writing a whole block of output.  They return the length of the run of
+         * ASCII characters at the start of the block, which is how much of that is right.
+         */
+
+        int bmp_ascii_run(const std::byte* const in, char* const out) noexcept {
+            using ops = detail::sse2_ops;
+            const auto a = ops::load(in);
+            const auto b = ops::load(in + 16);
+            //A big-endian unit is ASCII when its first octet is 0 and its second is under 0x80.
+            const auto non_ascii = _mm_set1_epi16(static_cast<short>(0x80ffu));
+            const auto ascii = _mm_packs_epi16(_mm_cmpeq_epi16(ops::and_(a, non_ascii), ops::zero()),
+                                               _mm_cmpeq_epi16(ops::and_(b, non_ascii), ops::zero()));
+            ops::store(reinterpret_cast<std::byte*>(out), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+            return std::countr_one(ops::high_bits(ascii));
+        }
+
+        /**
+         * Whether the next four BMP code units are all ASCII, which is a scalar check for a
+         * vector step being worth its whole block store.
+         */
+        bool bmp_ascii_ahead(const std::byte* const p) noexcept {
+            return (detail::load_le64(p) & 0x80ff80ff80ff80ffu) == 0;
+        }
+
+        int universal_ascii_run(const std::byte* const in, char* const out) noexcept {
+            using ops = detail::sse2_ops;
+            const auto non_ascii = _mm_set1_epi32(static_cast<int>(0x80ffffffu));
+            __m128i v[4];
+            __m128i is_ascii[4];
+            for (std::size_t i = 0; i < 4; ++i) {
+                v[i] = ops::load(in + i * 16);
+                is_ascii[i] = _mm_cmpeq_epi32(ops::and_(v[i], non_ascii), ops::zero());
+                v[i] = _mm_srli_epi32(v[i], 24);
+            }
+            const auto ascii = _mm_packs_epi16(_mm_packs_epi32(is_ascii[0], is_ascii[1]), _mm_packs_epi32(is_ascii[2], is_ascii[3]));
+            ops::store(reinterpret_cast<std::byte*>(out), _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+            return std::countr_one(ops::high_bits(ascii));
+        }
+
+        template <std::ptrdiff_t Width>
+        int utf8_ascii_run(const std::byte* const in, std::byte* const out) noexcept {
+            using ops = detail::sse2_ops;
+            const auto v = ops::load(in);
+            //Interleaving zeros in front of each octet widens them to big-endian units.
+            const auto lo = _mm_unpacklo_epi8(ops::zero(), v);
+            const auto hi = _mm_unpackhi_epi8(ops::zero(), v);
+            if constexpr (Width == 2) {
+                ops::store(out, lo);
+                ops::store(out + 16, hi);
+            }
+            else {
+                ops::store(out, _mm_unpacklo_epi16(ops::zero(), lo));
+                ops::store(out + 16, _mm_unpackhi_epi16(ops::zero(), lo));
+                ops::store(out + 32, _mm_unpacklo_epi16(ops::zero(), hi));
+                ops::store(out + 48, _mm_unpackhi_epi16(ops::zero(), hi));
+            }
+            return std::countr_zero(ops::high_bits(v) | 0x10000u);
+        }
+
+#endif
+
+        /**
+         * One BMP code unit to UTF-8.  Only code units which take three octets can be
+         * surrogates, so the ASCII and two octet cases don't check for them.
+         */
+        template <bool Checked>
+        decode_error put_bmp_char(const std::byte*& p, char*& o, [[maybe_unused]] char* const out_end) noexcept {
+            const auto cp = (std::to_integer<uint32_t>(p[0]) << 8) | std::to_integer<uint32_t>(p[1]);
+            if constexpr (Checked) {
+                if (out_end - o < utf8_size(cp)) {
+                    return decode_error::buffer_too_small;
+                }
+            }
+            if (cp < 0x80u) {
+                *o++ = static_cast<char>(cp);
+            }
+            else if (cp < 0x800u) {
+                o[0] = static_cast<char>(0xc0u | (cp >> 6));
+                o[1] = static_cast<char>(0x80u | (cp & 0x3fu));
+                o += 2;
+            }
+            else if (is_surrogate(cp)) {
+                return decode_error::invalid_string_character;
+            }
+            else {
+                o[0] = static_cast<char>(0xe0u | (cp >> 12));
+                o[1] = static_cast<char>(0x80u | ((cp >> 6) & 0x3fu));
+                o[2] = static_cast<char>(0x80u | (cp & 0x3fu));
+                o += 3;
+            }
+            p += 2;
+            return decode_error::none;
+        }
+
+        /*
+         * Each converter takes runs of ASCII a block at a time with a vector step, while there
+         * is a whole block of input and room for a whole block of output, then goes a
+         * character at a time until the next ASCII character.  Short strings and tails go a
+         * character at a time.  When Checked is false the caller has made sure out is big
+         * enough for the worst case.
+         *
+         * BMPString text mixes scripts in short strings often enough that a vector step which
+         * only gets a character or two wins nothing, so that converter stays on the character
+         * loop until the next four units are ASCII.
+         */
+
+        template <bool Checked>
+        decode_error bmp_to_utf8(const std::byte* p, const std::byte* const end, char*& o, [[maybe_unused]] char* const out_end) noexcept {
+#if defined(__SSE2__)
+            while (end - p >= 32) {
+                if ((!Checked || out_end - o >= 16) && bmp_ascii_ahead(p)) {
+                    const auto run = bmp_ascii_run(p, o);
+                    p += run * 2;
+                    o += run;
+                    if (run == 16) {
+                        continue;
+                    }
+                }
+                do {
+                    if (auto err = put_bmp_char<Checked>(p, o, out_end); err != decode_error::none) {
+                        return err;
+                    }
+                } while (end - p >= 32 && !bmp_ascii_ahead(p));
+            }
+#endif
+            while (p != end) {
+                if (auto err = put_bmp_char<Checked>(p, o, out_end); err != decode_error::none) {
+                    return err;
+                }
+            }
+            return decode_error::none;
+        }
+
+        template <bool Checked>
+        decode_error universal_to_utf8(const std::byte* p, const std::byte* const end, char*& o, [[maybe_unused]] char* const out_end) noexcept {
+            while (p != end) {
+#if defined(__SSE2__)
+                if (end - p >= 64 && (!Checked || out_end - o >= 16)) {
+                    const auto run = universal_ascii_run(p, o);
+                    p += run * 4;
+                    o += run;
+                    if (run == 16 || p == end) {
+                        continue;
+                    }
+                }
+#endif
+                do {
+                    const auto cp = detail::load_be32(p);
+                    if (cp > MAX_CODE_POINT || is_surrogate(cp)) {
+                        return decode_error::invalid_string_character;
+                    }
+                    if constexpr (Checked) {
+                        if (out_end - o < utf8_size(cp)) {
+                            return decode_error::buffer_too_small;
+                        }
+                    }
+                    o = put_utf8(cp, o);
+                    p += 4;
+                } while (p != end && detail::load_be32(p) >= 0x80u);
+            }
+            return decode_error::none;
+        }
+
+        /**
+         * UTF-8 to big-endian code units of Width octets (2 for BMPString, 4 for UniversalString).
+         */
+        template <std::ptrdiff_t Width, bool Checked>
+        decode_error utf8_to_units(const std::byte* p, const std::byte* const end, std::byte*& o, [[maybe_unused]] std::byte* const out_end) noexcept {
+            while (p != end) {
+#if defined(__SSE2__)
+                if (end - p >= 16 && (!Checked || out_end - o >= 16 * Width)) {
+                    const auto run = utf8_ascii_run<Width>(p, o);
+                    p += run;
+                    o += run * Width;
+                    if (run == 16 || p == end) {
+                        continue;
+                    }
+                }
+#endif
+                do {
+                    uint32_t cp = 0;
+                    const auto n = get_utf8(p, end, cp);
+                    if (n == 0) {
+                        return decode_error::invalid_utf8;
+                    }
+                    if constexpr (Width == 2) {
+                        if (cp > 0xffffu) {
+                            return decode_error::invalid_string_character;
+                        }
+                    }
+                    if constexpr (Checked) {
+                        if (out_end - o < Width) {
+                            return decode_error::buffer_too_small;
+                        }
+                    }
+                    for (std::ptrdiff_t i = Width - 1; i >= 0; --i) {
+                        o[i] = std::byte{static_cast<uint8_t>(cp)};
+                        cp >>= 8;
+                    }
+                    o += Width;
+                    p += n;
+                } while (p != end && (*p & std::byte{0x80u}) != std::byte{0});
+            }
+            return decode_error::none;
+        }
+
+        /**
+         * Big-endian code units, for building expected values in the tests.
+         */
+        std::vector<std::byte> to_units(const std::u32string& s, const std::size_t width) {
+            std::vector<std::byte> b;
+            b.reserve(s.size() * width);
+            for (auto c : s) {
+                for (auto i = width; i > 0; --i) {
+                    b.push_back(std::byte{static_cast<uint8_t>(c >> ((i - 1) * 8))});
+                }
+            }
+            return b;
+        }
+
+    }
+
+    decode_error try_bmp_to_utf8(const std::span<const std::byte> contents, const std::span<char> out, std::size_t& written) noexcept {
+        if (contents.size() % 2 != 0) {
+            return decode_error::invalid_string_length;
+        }
+        char* o = out.data();
+        const auto* const end = contents.data() + contents.size();
+        const auto err = out.size() >= max_utf8_size_of_bmp(contents.size()) ?
+                         bmp_to_utf8<false>(contents.data(), end, o, out.data() + out.size()) :
+                         bmp_to_utf8<true>(contents.data(), end, o, out.data() + out.size());
+        written = static_cast<std::size_t>(o - out.data());
+        return err;
+    }
+
+    decode_error try_universal_to_utf8(const std::span<const std::byte> contents, const std::span<char> out, std::size_t& written) noexcept {
+        if (contents.size() % 4 != 0) {
+            return decode_error::invalid_string_length;
+        }
+        char* o = out.data();
+        const auto* const end = contents.data() + contents.size();
+        const auto err = out.size() >= max_utf8_size_of_universal(contents.size()) ?
+                         universal_to_utf8<false>(contents.data(), end, o, out.data() + out.size()) :
+                         universal_to_utf8<true>(contents.data(), end, o, out.data() + out.size());
+        written = static_cast<std::size_t>(o - out.data());
+        return err;
+    }
+
+    decode_error try_utf8_to_bmp(const std::string_view utf8, const std::span<std::byte> out, std::size_t& written) noexcept {
+        std::byte* o = out.data();
+        const auto* const begin = reinterpret_cast<const std::byte*>(utf8.data());
+        const auto err = out.size() >= max_bmp_size_of_utf8(utf8.size()) ?
+                         utf8_to_units<2, false>(begin, begin + utf8.size(), o, out.data() + out.size()) :
+                         utf8_to_units<2, true>(begin, begin + utf8.size(), o, out.data() + out.size());
+        written = static_cast<std::size_t>(o - out.data());
+        return err;
+    }
+
+    decode_error try_utf8_to_universal(const std::string_view utf8, const std::span<std::byte> out, std::size_t& written) noexcept {
+        std::byte* o = out.data();
+        const auto* const begin = reinterpret_cast<const std::byte*>(utf8.data());
+        const auto err = out.size() >= max_universal_size_of_utf8(utf8.size()) ?
+                         utf8_to_units<4, false>(begin, begin + utf8.size(), o, out.data() + out.size()) :
+                         utf8_to_units<4, true>(begin, begin + utf8.size(), o, out.data() + out.size());
+        written = static_cast<std::size_t>(o - out.data());
+        return err;
+    }
+
+    decode_error try_string_to_utf8(const tag& t, const std::span<const std::byte> contents, const std::span<char> out, std::size_t& written) noexcept {
+        if (t.constructed) {
+            //The contents are segments, not characters.
+            return decode_error::primitive_encoding_required;
+        }
+        else if (const auto type = string_type_of(t)) {
+            std::string_view view;
+            if (auto err = try_decode_string(*type, contents, view); err != decode_error::none) {
+                return err;
+            }
+            else if (out.size() < view.size()) {
+                return decode_error::buffer_too_small;
+            }
+            if (!view.empty()) {
+                std::memcpy(out.data(), view.data(), view.size());
+            }
+            written = view.size();
+            return decode_error::none;
+        }
+        else if (t.tag_class == tag_class_type::universal && t.tag_number == universal_tags::bmp_string::value.tag_number) {
+            return try_bmp_to_utf8(contents, out, written);
+        }
+        else if (t.tag_class == tag_class_type::universal && t.tag_number == universal_tags::universal_string::value.tag_number) {
+            return try_universal_to_utf8(contents, out, written);
+        }
+        return decode_error::unsupported_string_type;
+    }
+
+    std::string string_to_utf8(const tag& t, const std::span<const std::byte> contents) {
+        std::string retval(max_utf8_size(t, contents.size()), '\0');
+        std::size_t written = 0;
+        if (auto err = try_string_to_utf8(t, contents, retval, written); err != decode_error::none) {
+            throw_decode_error(err, "character string");
+        }
+        retval.resize(written);
+        return retval;
+    }
+
+    TEST_CASE("string_to_utf8") {
+        //"Zürich €" and a character outside the BMP.
+        const std::u32string text = U"Zürich €";
+        const std::string utf8 = "Z\xc3\xbcrich \xe2\x82\xac";
+        CHECK_EQ(string_to_utf8(universal_tags::bmp_string::value, to_units(text, 2)), utf8);
+        CHECK_EQ(string_to_utf8(universal_tags::universal_string::value, to_units(text, 4)), utf8);
+        CHECK_EQ(string_to_utf8(universal_tags::universal_string::value, to_units(U"\U0001f600", 4)), "\xf0\x9f\x98\x80");
+        CHECK_EQ(string_to_utf8(universal_tags::printable_string::value, to_bytes("Example")), "Example");
+        CHECK_EQ(string_to_utf8(universal_tags::bmp_string::value, {}), "");
+
+        std::array<std::byte, 64> units{};
+        std::size_t written = 0;
+        REQUIRE_EQ(try_utf8_to_bmp(utf8, units, written), decode_error::none);
+        CHECK_EQ(std::vector<std::byte>(units.begin(), units.begin() + static_cast<std::ptrdiff_t>(written)), to_units(text, 2));
+        REQUIRE_EQ(try_utf8_to_universal(utf8, units, written), decode_error::none);
+        CHECK_EQ(std::vector<std::byte>(units.begin(), units.begin() + static_cast<std::ptrdiff_t>(written)), to_units(text, 4));
+
+        std::array<char, 64> chars{};
+        CHECK_EQ(try_bmp_to_utf8(to_bytes("abc"), chars, written), decode_error::invalid_string_length);
+        CHECK_EQ(try_bmp_to_utf8(to_units(U"a\xd800", 2), chars, written), decode_error::invalid_string_character);
+        CHECK_EQ(try_bmp_to_utf8(to_units(U"abcdefghijklmnopqrstuvwxyz\xdfff" U"0123", 2), chars, written), decode_error::invalid_string_character);
+        CHECK_EQ(try_universal_to_utf8(to_bytes(std::string_view{"\0\x11\0\0", 4}), chars, written), decode_error::invalid_string_character);
+        CHECK_EQ(try_utf8_to_bmp("\xf0\x9f\x98\x80", units, written), decode_error::invalid_string_character);
+        CHECK_EQ(try_utf8_to_bmp("\xc0\x80", units, written), decode_error::invalid_utf8);
+        CHECK_EQ(try_utf8_to_universal("ab\xe2\x82", units, written), decode_error::invalid_utf8);
+        CHECK_EQ(try_string_to_utf8(universal_tags::octet_string::value, {}, chars, written), decode_error::unsupported_string_type);
+        CHECK_EQ(try_string_to_utf8({tag_class_type::universal, true, 30}, {}, chars, written), decode_error::primitive_encoding_required);
+        CHECK_THROWS_AS(string_to_utf8(universal_tags::ia5_string::value, to_bytes("\xff")), exception);
+
+        //Buffers which are too small only by the last character.
+        std::array<char, 3> small{};
+        CHECK_EQ(try_bmp_to_utf8(to_units(U"abü", 2), small, written), decode_error::buffer_too_small);
+        CHECK_EQ(try_bmp_to_utf8(to_units(U"aü", 2), small, written), decode_error::none);
+        CHECK_EQ(written, 3u);
+        CHECK_EQ(try_string_to_utf8(universal_tags::utf8_string::value, to_bytes("abcd"), small, written), decode_error::buffer_too_small);
+
+        //Random text with runs of ASCII long enough for the block paths, in every direction and
+        //  with buffers of exactly the right size (which take the checked paths).
+        std::mt19937 rng{23};
+        for (int i = 0; i < 2000; ++i) {
+            std::u32string s;
+            const auto len = rng() % 100;
+            const bool bmp_only = rng() % 2 == 0;
+            while (s.size() < len) {
+                switch (rng() % 4) {
+                    case 0: s.append(rng() % 40, static_cast<char32_t>('a' + rng() % 26)); break;
+                    case 1: s.push_back(static_cast<char32_t>(0x80 + rng() % 0x780)); break;
+                    case 2: s.push_back(static_cast<char32_t>(0xe000 + rng() % 0x2000)); break;
+                    default: s.push_back(bmp_only ? U'x' : static_cast<char32_t>(0x10000 + rng() % 0x100000)); break;
+                }
+            }
+            std::string expected;
+            std::array<char, 4> buf{};
+            for (auto c : s) {
+                expected.append(buf.data(), static_cast<std::size_t>(put_utf8(c, buf.data()) - buf.data()));
+            }
+
+            const auto ucs4 = to_units(s, 4);
+            std::string out(expected.size(), '\0');
+            REQUIRE_EQ(try_universal_to_utf8(ucs4, out, written), decode_error::none);
+            CHECK_EQ(out.substr(0, written), expected);
+            std::vector<std::byte> back(ucs4.size());
+            REQUIRE_EQ(try_utf8_to_universal(expected, back, written), decode_error::none);
+            CHECK_EQ(back, ucs4);
+
+            if (bmp_only) {
+                const auto ucs2 = to_units(s, 2);
+                CHECK_EQ(string_to_utf8(universal_tags::bmp_string::value, ucs2), expected);
+                REQUIRE_EQ(try_bmp_to_utf8(ucs2, out, written), decode_error::none);
+                CHECK_EQ(out.substr(0, written), expected);
+                back.resize(ucs2.size());
+                REQUIRE_EQ(try_utf8_to_bmp(expected, back, written), decode_error::none);
+                CHECK_EQ(back, ucs2);
+            }
+        }
+    }
+
+} /* namespace dabers */
@@ -4,36 +4,39 @@
 
 #include "dabers/tag.h"
 #include "buffer_check.h"
+#include "decode_detail.h"
 #include "exception.h"
+#include "test_util.h"
 
 #include <doctest/doctest.h>
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 
 #include <algorithm>
+#include <random>
 #include <vector>
 
 namespace dabers {
 
     namespace {
 
-        constexpr int MAX_TAG_NUM_LENGTH = 9;
-
         tag test_parse_tag(const std::vector<unsigned int>& v) {
-            std::vector<std::byte> b;
-            b.reserve(v.size());
-            std::transform(v.begin(), v.end(), std::back_inserter(b),
-                           [](unsigned int a){ return static_cast<std::byte>(a); });
+            const auto b = to_bytes(v);
             const std::byte* beg = b.data();
             return parse_tag(beg, b.data() + b.size());
         }
 
+        decode_error test_try_parse_tag(const std::vector<unsigned int>& v) {
+            const auto b = to_bytes(v);
+            const std::byte* beg = b.data();
+            tag t;
+            return try_parse_tag(beg, b.data() + b.size(), t);
+        }
+
         bool test_write_tag(const tag& t, const std::vector<unsigned int>& exp) {
             std::vector<std::byte> output;
             write_tag(t, std::back_inserter(output));
-            return std::equal(output.begin(), output.end(),
-                              exp.begin(), exp.end(),
-                              [](std::byte a, unsigned int b){ return a == std::byte{static_cast<uint8_t>(b)}; });
+            return output == to_bytes(exp);
         }
 
     }
@@ -78,38 +81,32 @@ namespace dabers {
         return os;
     }
 
+    decode_error detail::try_parse_long_form_tag(const std::byte*& begin, const std::byte* const end, tag& out) noexcept {
+        if (auto err = try_check_buffer(begin, end, 1); err != decode_error::none) {
+            return err;
+        }
+        else if (static_cast<std::size_t>(end - begin) >= detail::max_decoded_tag_size) {
+            return detail::decode_tag<false>(begin, end, out);
+        }
+        return detail::decode_tag<true>(begin, end, out);
+    }
+
     tag parse_tag(const std::byte*& begin, const std::byte* const end) {
-        auto* first = consume_buffer(begin, end, 1);
-        auto cl = static_cast<tag_class_type>(*first & std::byte{0xc0u});
-        auto is_cons = (*first & std::byte{0x20u}) != std::byte{0};
-        auto num = static_cast<uint64_t>(*first & std::byte{0x1fu});
-        if (num == 0x1fu) {
-            uint64_t num_bits = 0;
-            bool more = true, first_num = true;
-            int count = 0;
-            while (more) {
-                auto* next = consume_buffer(begin, end, 1);
-                more = (*next & std::byte{0x80u}) != std::byte{0};
-                if (more && first_num && (*next & std::byte{0x7fu}) == std::byte{0}) {
-                    throw_ex("The first octet of an extended tag number "
-                             "cannot have 0 for the number bits.");
-                }
-                num_bits <<= 7;
-                num_bits |= static_cast<uint8_t>(*next & std::byte{0x7fu});
-                ++count;
-                first_num = false;
-            }
-            if (count > MAX_TAG_NUM_LENGTH) {
-                throw_ex("The length of the tag ({}) is more than the "
-                         "maximum supported by this library ({}).",
-                         count, MAX_TAG_NUM_LENGTH);
-            }
-            else if (num_bits < 31) {
-                throw_ex("The extended tag number cannot have a value less than 31 (0x1f).");
-            }
-            num = num_bits;
+        tag retval;
+        if (auto err = try_parse_tag(begin, end, retval); err != decode_error::none) {
+            throw_decode_error(err, "tag");
+        }
+        return retval;
+    }
+
+    TEST_CASE("identifier_octet_table") {
+        for (unsigned int i = 0; i < 256; ++i) {
+            const auto& e = detail::identifier_octet_table[i];
+            CHECK_EQ(static_cast<unsigned int>(e.tag_class), i & 0xc0u);
+            CHECK_EQ(e.constructed, (i & 0x20u) != 0);
+            CHECK_EQ(e.tag_number, i & 0x1fu);
+            CHECK_EQ(e.long_form, (i & 0x1fu) == 0x1fu);
         }
-        return {cl, is_cons, num};
     }
 
     TEST_CASE("parse_tag success") {
@@ -131,6 +128,7 @@ namespace dabers {
         CHECK_EQ(test_parse_tag({0x1fu, 0x81u, 0x01u}), tag{tag_class_type::universal, false, 129});
 
         CHECK_EQ(test_parse_tag({0x1fu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu}), tag{tag_class_type::universal, false, 0x7fffffffffffffffu});
+        CHECK_EQ(test_parse_tag({0x1fu, 0x81u, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu}), tag{tag_class_type::universal, false, 0xffffffffffffffffu});
 
         //Check with buffer with extra data.
         CHECK_EQ(test_parse_tag({0x1fu, 0x81u, 0x00u, 0x8au, 0x0bu, 0x8cu, 0x0du}), tag{tag_class_type::universal, false, 128});
@@ -167,30 +165,84 @@ namespace dabers {
         CHECK_THROWS_AS(test_parse_tag({0x1fu, 0x80u, 0xffu, 0xffu, 0xffu, 0x7fu}), exception);
     }
 
+    TEST_CASE("try_parse_tag") {
+        CHECK_EQ(test_try_parse_tag({0xa3u}), decode_error::none);
+        CHECK_EQ(test_try_parse_tag({0x1fu, 0x81u, 0x00u}), decode_error::none);
+        CHECK_NE(test_try_parse_tag({}), decode_error::none);
+        CHECK_EQ(test_try_parse_tag({0x1fu}), decode_error::buffer_too_small);
+        CHECK_EQ(test_try_parse_tag({0x1fu, 0x81u, 0x81u}), decode_error::buffer_too_small);
+        CHECK_EQ(test_try_parse_tag({0x1fu, 0x1eu}), decode_error::tag_number_too_small);
+        CHECK_EQ(test_try_parse_tag({0x1fu, 0x80u, 0xffu, 0xffu, 0xffu, 0x7fu}), decode_error::tag_number_leading_zero);
+        CHECK_EQ(test_try_parse_tag({0x1fu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu}), decode_error::tag_number_too_long);
+
+        const std::byte* null = nullptr;
+        tag t;
+        CHECK_EQ(try_parse_tag(null, null, t), decode_error::null_buffer);
+        const std::vector<std::byte> two{std::byte{0x02u}, std::byte{0x02u}};
+        const std::byte* second = two.data() + 1;
+        CHECK_EQ(try_parse_tag(second, null, t), decode_error::null_buffer);
+        CHECK_EQ(try_parse_tag(second, two.data(), t), decode_error::buffer_too_small);
+        CHECK_EQ(second, two.data() + 1);
+
+        //The buffer shouldn't move on failure.
+        std::vector<std::byte> buf{std::byte{0x1fu}, std::byte{0x81u}};
+        const std::byte* beg = buf.data();
+        CHECK_EQ(try_parse_tag(beg, buf.data() + buf.size(), t), decode_error::buffer_too_small);
+        CHECK_EQ(beg, buf.data());
+    }
+
     void write_tag(const tag& t, const std::function<void(std::byte)>& output) {
-        auto first = std::byte{static_cast<uint8_t>(t.tag_class)};
-        first |= t.constructed ? std::byte{0x20u} : std::byte{0};
-        if (t.tag_number > 30) {
-            constexpr int NSIZE = 7;
-            first |= std::byte{0x1fu};
-            output(first);
-            uint64_t mask = 0x7f00000000000000u;
-            int num = 8;
-            bool found = false;
-            while (mask != 0) {
-                if (found || t.tag_number & mask) {
-                    uint8_t val = static_cast<bool>(num) * 0x80u;
-                    val |= (t.tag_number & mask) >> (num * NSIZE);
-                    output(std::byte{val});
-                    found = true;
+        write_tag(t, function_sink<const std::function<void(std::byte)>>{output});
+    }
+
+    TEST_CASE("try_parse_tag high tag numbers") {
+        //Base-128 groups straight through the wide decoder, including what follows the number.
+        std::vector<std::byte> b = to_bytes({0x81u, 0x80u, 0x7fu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu});
+        uint64_t num = 0;
+        CHECK_EQ(detail::decode_base128_8(b.data(), num), 3);
+        CHECK_EQ(num, (1u << 14) + 0x7fu);
+        b = to_bytes({0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu});
+        CHECK_EQ(detail::decode_base128_8(b.data(), num), 8);
+        CHECK_EQ(num, (uint64_t{1} << 56) - 1);
+        b = to_bytes({0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu});
+        CHECK_EQ(detail::decode_base128_8(b.data(), num), 0);
+
+        //Every length of tag number, with the buffer ending right after it (the byte loop)
+        //  and with room to spare (the wide load).
+        std::mt19937_64 rng{11};
+        std::size_t mismatches = 0;
+        for (unsigned int bits = 5; bits <= 64; ++bits) {
+            for (int trial = 0; trial < 20; ++trial) {
+                const auto number = std::max<uint64_t>(31, (rng() >> (64 - bits)) | (uint64_t{1} << (bits - 1)));
+                const tag t{tag_class_type::private_class, trial % 2 == 0, number};
+                std::vector<std::byte> buf(max_encoded_tag_size + 4, std::byte{0xffu});
+                const auto size = encode_tag(t, buf.data());
+                for (auto len : {size, size + 1, buf.size()}) {
+                    const std::byte* beg = buf.data();
+                    tag out;
+                    if (try_parse_tag(beg, buf.data() + len, out) != decode_error::none || out != t || beg != buf.data() + size) {
+                        ++mismatches;
+                    }
                 }
-                mask >>= NSIZE;
-                --num;
             }
         }
-        else {
-            first |= std::byte{static_cast<uint8_t>(t.tag_number)};
-            output(first);
+        CHECK_EQ(mismatches, 0);
+
+        //Failures are the same on both paths:  the padding gives the wide load room to run.
+        for (std::size_t pad : {0u, 16u}) {
+            auto check = [pad](std::vector<unsigned int> v, decode_error exp) {
+                auto buf = to_bytes(v);
+                buf.resize(buf.size() + pad);
+                const std::byte* beg = buf.data();
+                tag t;
+                CHECK_EQ(try_parse_tag(beg, buf.data() + buf.size(), t), exp);
+                CHECK_EQ(beg, buf.data());
+            };
+            check({0x1fu, 0x80u, 0x01u}, decode_error::tag_number_leading_zero);
+            check({0x1fu, 0x1eu}, decode_error::tag_number_too_small);
+            //More than 64 bits, in ten groups and in eleven.
+            check({0x1fu, 0x82u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x00u}, decode_error::tag_number_too_long);
+            check({0x1fu, 0x81u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x00u}, decode_error::tag_number_too_long);
         }
     }
 
@@ -213,6 +265,59 @@ namespace dabers {
         CHECK(test_write_tag(tag{tag_class_type::universal, false, 129}, {0x1fu, 0x81u, 0x01u}));
 
         CHECK(test_write_tag(tag{tag_class_type::universal, false, 0x7fffffffffffffffu}, {0x1fu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu}));
+        CHECK(test_write_tag(tag{tag_class_type::universal, false, 0xffffffffffffffffu}, {0x1fu, 0x81u, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu}));
+    }
+
+    TEST_CASE("write_tag sinks") {
+        for (uint64_t num : {0ull, 30ull, 31ull, 127ull, 128ull, 16383ull, 16384ull, 0x7fffffffffffffffull}) {
+            const tag t{tag_class_type::context_specific, true, num};
+            std::vector<std::byte> by_sink, by_iter, by_func, by_std_func, by_contig(max_encoded_tag_size);
+            std::array<std::byte, max_encoded_tag_size> by_span{};
+            write_tag(t, vector_sink{by_sink});
+            write_tag(t, std::back_inserter(by_iter));
+            write_tag(t, [&by_func](std::byte b){ by_func.push_back(b); });
+            write_tag(t, std::function<void(std::byte)>{[&by_std_func](std::byte b){ by_std_func.push_back(b); }});
+            span_sink ss{by_span.data(), by_span.data() + by_span.size()};
+            write_tag(t, ss);
+            iterator_sink is{by_contig.begin()};
+            write_tag(t, is);
+
+            CHECK_EQ(by_sink, by_iter);
+            CHECK_EQ(by_sink, by_func);
+            CHECK_EQ(by_sink, by_std_func);
+            CHECK(std::equal(by_sink.begin(), by_sink.end(), by_span.data(), ss.position()));
+            CHECK(std::equal(by_sink.begin(), by_sink.end(), by_contig.begin(), is.position()));
+
+            const std::byte* beg = by_sink.data();
+            CHECK_EQ(parse_tag(beg, by_sink.data() + by_sink.size()), t);
+        }
+    }
+
+    static_assert(universal_tags::sequence::size == 1);
+    static_assert(universal_tags::sequence::bytes[0] == std::byte{0x30u});
+    static_assert(static_tag<tag_class_type::context_specific, true, 3>::bytes[0] == std::byte{0xa3u});
+    static_assert(static_tag<tag_class_type::application, false, 200>::bytes == std::array{std::byte{0x5fu}, std::byte{0x81u}, std::byte{0x48u}});
+    static_assert(encode_tag<tag{tag_class_type::private_class, true, 31}>() == std::array{std::byte{0xffu}, std::byte{0x1fu}});
+
+    TEST_CASE("static_tag") {
+        for (uint64_t num : {0ull, 30ull, 31ull, 127ull, 128ull, 16383ull, 16384ull, 0x7fffffffffffffffull, 0xffffffffffffffffull}) {
+            std::array<std::byte, max_encoded_tag_size> buf{};
+            CHECK_EQ(encode_tag(tag{tag_class_type::universal, false, num}, buf.data()), encoded_tag_size(num));
+        }
+
+        using app200 = static_tag<tag_class_type::application, false, 200>;
+        std::vector<std::byte> out;
+        app200::write(vector_sink{out});
+        universal_tags::octet_string::write(vector_sink{out});
+        CHECK_EQ(out.size(), 4u);
+        CHECK(app200::matches(out));
+        CHECK_FALSE(universal_tags::octet_string::matches(out));
+        CHECK(universal_tags::octet_string::matches(std::span{out}.subspan(3)));
+        CHECK_FALSE(app200::matches(std::span{out}.subspan(2)));
+
+        const std::byte* beg = out.data();
+        CHECK_EQ(parse_tag(beg, out.data() + out.size()), app200::value);
+        CHECK_EQ(parse_tag(beg, out.data() + out.size()), universal_tags::octet_string::value);
     }
 
 } /* namespace dabers */
\ No newline at end of file
@@ -0,0 +1,126 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/tape.h"
+#include "dabers/codec.h"
+#include "dabers/header.h"
+#include "element_walk.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+namespace dabers {
+
+    decode_error tape::build(const std::span<const std::byte> document, const rules r) {
+        return with_codec(r, [&](auto c){ return build_with<decltype(c)>(document); });
+    }
+
+    template <typename Codec>
+    decode_error tape::build_with(const std::span<const std::byte> document) {
+        static_assert(npos == detail::no_element);
+        m_document = document;
+        m_entries.clear();
+
+        auto on_element = [this](const tlv_header& h, const std::byte* element, uint32_t index, uint32_t parent, uint32_t prev_sibling) {
+            if (h.id.tag_number > max_packed_tag_number) {
+                return decode_error::tag_number_too_long;
+            }
+            if (prev_sibling != npos) {
+                m_entries[prev_sibling].next_sibling = index;
+            }
+            m_entries.push_back({static_cast<uint64_t>(element - m_document.data()),
+                                 h.length.value_or(0),
+                                 pack_tag(h.id),
+                                 parent,
+                                 npos,
+                                 static_cast<uint8_t>(h.header_size),
+                                 h.indefinite()});
+            return decode_error::none;
+        };
+        auto on_end_of_contents = [this](uint32_t index, const std::byte* eoc) {
+            auto& e = m_entries[index];
+            e.content_length = static_cast<uint64_t>(eoc - m_document.data()) - e.offset - e.header_size;
+        };
+        if (auto err = detail::walk_elements<Codec>(document, m_open, 0, on_element, on_end_of_contents); err != decode_error::none) {
+            m_entries.clear();
+            return err;
+        }
+        return decode_error::none;
+    }
+
+    TEST_CASE("pack_tag") {
+        for (const tag& t : {tag{tag_class_type::universal, false, 0},
+                             tag{tag_class_type::application, true, 31},
+                             tag{tag_class_type::context_specific, false, 12345},
+                             tag{tag_class_type::private_class, true, max_packed_tag_number}}) {
+            CHECK_EQ(unpack_tag(pack_tag(t)), t);
+        }
+        CHECK_LT(pack_tag({tag_class_type::universal, true, 5}), pack_tag({tag_class_type::application, false, 0}));
+        CHECK_LT(pack_tag({tag_class_type::context_specific, true, 1}), pack_tag({tag_class_type::context_specific, false, 2}));
+        CHECK_LT(pack_tag({tag_class_type::private_class, false, 2}), pack_tag({tag_class_type::private_class, true, 2}));
+    }
+
+    TEST_CASE("tape build") {
+        const auto buf = sample_document();
+        tape t;
+        REQUIRE_EQ(t.build(buf), decode_error::none);
+        REQUIRE_EQ(t.size(), 7u);
+
+        CHECK_EQ(t.id(0), tag{tag_class_type::universal, true, 16});
+        CHECK_EQ(t.parent(0), tape::npos);
+        CHECK_EQ(t.next_sibling(0), 6u);
+        CHECK_EQ(t.first_child(0), 1u);
+        CHECK_EQ(t.encoded(0).size(), 18u);
+
+        CHECK_EQ(t.id(1), tag{tag_class_type::universal, false, 2});
+        CHECK_EQ(t.parent(1), 0u);
+        CHECK_EQ(t.next_sibling(1), 2u);
+        CHECK_EQ(t.first_child(1), tape::npos);
+        CHECK_EQ(t.contents(1)[0], std::byte{0x05u});
+
+        CHECK(t[2].indefinite);
+        CHECK_EQ(t[2].content_length, 6u);
+        CHECK_EQ(t.encoded(2).size(), 10u);
+        CHECK_EQ(t.first_child(2), 3u);
+        CHECK_EQ(t.next_sibling(2), 5u);
+
+        CHECK_EQ(t.id(3), tag{tag_class_type::universal, false, 4});
+        CHECK_EQ(t.parent(3), 2u);
+        CHECK_EQ(t.next_sibling(3), 4u);
+        CHECK_EQ(t.contents(3).size(), 2u);
+
+        CHECK_EQ(t.id(4), tag{tag_class_type::context_specific, true, 0});
+        CHECK_EQ(t.first_child(4), tape::npos);
+        CHECK_EQ(t.next_sibling(4), tape::npos);
+
+        CHECK_EQ(t.parent(5), 0u);
+        CHECK_EQ(t.next_sibling(5), tape::npos);
+
+        CHECK_EQ(t.id(6), tag{tag_class_type::universal, false, 5});
+        CHECK_EQ(t.parent(6), tape::npos);
+        CHECK_EQ(t.next_sibling(6), tape::npos);
+        CHECK_EQ(t[6].offset, 18u);
+    }
+
+    TEST_CASE("tape build failures") {
+        tape t;
+        //Missing end-of-contents octets.
+        auto buf = to_bytes({0x30u, 0x80u, 0x02u, 0x01u, 0x05u});
+        CHECK_EQ(t.build(buf), decode_error::buffer_too_small);
+        CHECK(t.empty());
+        //Child longer than its parent.
+        buf = to_bytes({0x30u, 0x03u, 0x02u, 0x02u, 0x05u, 0x06u});
+        CHECK_EQ(t.build(buf), decode_error::buffer_too_small);
+        //Indefinite length element running past the end of its definite length parent.
+        buf = to_bytes({0x30u, 0x04u, 0x30u, 0x80u, 0x05u, 0x00u, 0x00u, 0x00u});
+        CHECK_EQ(t.build(buf), decode_error::buffer_too_small);
+        //Indefinite length in DER.
+        buf = to_bytes({0x30u, 0x80u, 0x00u, 0x00u});
+        CHECK_EQ(t.build(buf, rules::der), decode_error::indefinite_length_forbidden);
+        //Tag number too big to pack.
+        buf = to_bytes({0x1fu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0x7fu, 0x00u});
+        CHECK_EQ(t.build(buf), decode_error::tag_number_too_long);
+    }
+
+} /* namespace dabers */
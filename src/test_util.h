@@ -0,0 +1,77 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#ifndef DABERS_TEST_UTIL_H
+#define DABERS_TEST_UTIL_H
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/**
+ * Helpers shared by the test cases compiled into the library.
+ */
+namespace dabers {
+
+    inline std::vector<std::byte> to_bytes(const std::span<const unsigned int> v) {
+        std::vector<std::byte> b;
+        b.reserve(v.size());
+        for (auto a : v) {
+            b.push_back(static_cast<std::byte>(a));
+        }
+        return b;
+    }
+
+    /**
+     * For braced lists, which a span can't be made from.
+     */
+    inline std::vector<std::byte> to_bytes(const std::initializer_list<unsigned int> v) {
+        return to_bytes(std::span{v.begin(), v.size()});
+    }
+
+    inline std::vector<std::byte> to_bytes(const std::string_view s) {
+        std::vector<std::byte> b(s.size());
+        if (!s.empty()) {
+            std::memcpy(b.data(), s.data(), s.size());
+        }
+        return b;
+    }
+
+    /**
+     * SEQUENCE { INTEGER 5, SEQUENCE (indefinite) { OCTET STRING "ab", [0] { } }, BOOLEAN TRUE } NULL
+     *
+     * Seven elements covering two top-level elements, both length forms, nesting in both
+     * and an empty constructed element.  The outer SEQUENCE is the first 18 octets.
+     */
+    inline std::vector<std::byte> sample_document() {
+        return to_bytes({0x30u, 0x10u,
+                             0x02u, 0x01u, 0x05u,
+                             0x30u, 0x80u,
+                                 0x04u, 0x02u, 0x61u, 0x62u,
+                                 0xa0u, 0x00u,
+                             0x00u, 0x00u,
+                             0x01u, 0x01u, 0xffu,
+                         0x05u, 0x00u});
+    }
+
+    /**
+     * sample_document with the inner SEQUENCE given a definite length, which makes it DER.
+     * The outer SEQUENCE is the first 16 octets.
+     */
+    inline std::vector<std::byte> sample_der_document() {
+        return to_bytes({0x30u, 0x0eu,
+                             0x02u, 0x01u, 0x05u,
+                             0x30u, 0x06u,
+                                 0x04u, 0x02u, 0x61u, 0x62u,
+                                 0xa0u, 0x00u,
+                             0x01u, 0x01u, 0xffu,
+                         0x05u, 0x00u});
+    }
+
+} /* namespace dabers */
+
+#endif //DABERS_TEST_UTIL_H
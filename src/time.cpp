@@ -0,0 +1,365 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/time.h"
+#include "exception.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dabers {
+
+    namespace {
+
+        using namespace std::chrono;
+
+        struct time_fields {
+            int year = 0;
+            int month = 0;
+            int day = 0;
+            int hour = 0;
+            int minute = 0;
+            int second = 0;
+            int64_t microseconds = 0;
+            /**
+             * Minutes ahead of UTC.
+             */
+            int offset = 0;
+        };
+
+        decode_error fields_to_time(const time_fields& f, asn1_time& out) noexcept {
+            if (auto err = detail::to_time(f.year, f.month, f.day, f.hour, f.minute, f.second, out); err != decode_error::none) {
+                return err;
+            }
+            out += minutes{-f.offset} + microseconds{f.microseconds};
+            return decode_error::none;
+        }
+
+        /**
+         * Reads characters off the contents for the forms which aren't the fixed one.
+         */
+        class time_reader {
+        public:
+            explicit time_reader(const std::span<const std::byte> contents) noexcept :
+                m_cur{reinterpret_cast<const char*>(contents.data())}, m_end{m_cur + contents.size()} {}
+
+            [[nodiscard]] bool at_end() const noexcept { return m_cur == m_end; }
+            [[nodiscard]] bool at_digit() const noexcept { return m_cur != m_end && *m_cur >= '0' && *m_cur <= '9'; }
+            [[nodiscard]] char peek() const noexcept { return m_cur != m_end ? *m_cur : '\0'; }
+
+            bool next(const char c) noexcept {
+                if (peek() == c) {
+                    ++m_cur;
+                    return true;
+                }
+                return false;
+            }
+
+            /**
+             * Reads two digits.
+             * @return The value, or -1 if they aren't there.
+             */
+            int two_digits() noexcept {
+                if (m_end - m_cur < 2 || m_cur[0] < '0' || m_cur[0] > '9' || m_cur[1] < '0' || m_cur[1] > '9') {
+                    return -1;
+                }
+                const auto v = (m_cur[0] - '0') * 10 + (m_cur[1] - '0');
+                m_cur += 2;
+                return v;
+            }
+
+            /**
+             * Reads the digits of a fraction, as billionths.
+             * @param digits The number of digits, including any dropped.
+             * @param trailing_zero Whether the last digit is 0.
+             */
+            int64_t fraction(int& digits, bool& trailing_zero) noexcept {
+                int64_t v = 0;
+                digits = 0;
+                trailing_zero = false;
+                for (; at_digit(); ++m_cur, ++digits) {
+                    if (digits < 9) {
+                        v = v * 10 + (*m_cur - '0');
+                    }
+                    trailing_zero = *m_cur == '0';
+                }
+                for (auto i = digits; i < 9; ++i) {
+                    v *= 10;
+                }
+                return v;
+            }
+
+            /**
+             * Reads Z or a +hh[mm]/-hh[mm] offset, which must end the contents.
+             * @param with_minutes Whether the minutes of an offset are required.
+             * @param zulu Set to whether it was Z.
+             */
+            decode_error zone(const bool with_minutes, int& offset, bool& zulu) noexcept {
+                zulu = next('Z');
+                if (zulu) {
+                    offset = 0;
+                }
+                else if (peek() == '+' || peek() == '-') {
+                    const auto sign = *m_cur++ == '-' ? -1 : 1;
+                    const auto h = two_digits();
+                    const auto m = with_minutes || !at_end() ? two_digits() : 0;
+                    if (h < 0 || h > 23 || m < 0 || m > 59) {
+                        return decode_error::invalid_time;
+                    }
+                    offset = sign * (h * 60 + m);
+                }
+                else {
+                    //Without either this is a local time, which isn't any one point in time.
+                    return decode_error::invalid_time;
+                }
+                return at_end() ? decode_error::none : decode_error::invalid_time;
+            }
+
+        private:
+            const char* m_cur;
+            const char* m_end;
+        };
+
+        char* put_digits(char* const o, const int v) noexcept {
+            o[0] = static_cast<char>('0' + v / 10);
+            o[1] = static_cast<char>('0' + v % 10);
+            return o + 2;
+        }
+
+        /**
+         * Writes YYMMDDhhmmss or YYYYMMDDhhmmss, then a fraction without trailing zeros if
+         * there is one, then Z.
+         */
+        std::size_t encode_time(const asn1_time t, std::byte* const out, const bool four_digit_year, const bool fraction) {
+            const auto dp = floor<days>(t);
+            const year_month_day ymd{dp};
+            const hh_mm_ss tod{t - dp};
+            const auto y = static_cast<int>(ymd.year());
+            char* o = reinterpret_cast<char*>(out);
+            if (four_digit_year) {
+                if (y < 0 || y > 9999) {
+                    throw_ex("A GeneralizedTime can't have the year {}.", y);
+                }
+                o = put_digits(o, y / 100);
+            }
+            else if (y < 1950 || y > 2049) {
+                throw_ex("A UTCTime can't have the year {}.", y);
+            }
+            o = put_digits(o, y % 100);
+            o = put_digits(o, static_cast<int>(static_cast<unsigned int>(ymd.month())));
+            o = put_digits(o, static_cast<int>(static_cast<unsigned int>(ymd.day())));
+            o = put_digits(o, static_cast<int>(tod.hours().count()));
+            o = put_digits(o, static_cast<int>(tod.minutes().count()));
+            o = put_digits(o, static_cast<int>(tod.seconds().count()));
+            if (auto us = tod.subseconds().count(); fraction && us != 0) {
+                *o = '.';
+                int digits = 6;
+                for (; us % 10 == 0; us /= 10) {
+                    --digits;
+                }
+                for (auto i = digits; i > 0; --i) {
+                    o[i] = static_cast<char>('0' + us % 10);
+                    us /= 10;
+                }
+                o += digits + 1;
+            }
+            *o++ = 'Z';
+            return static_cast<std::size_t>(o - reinterpret_cast<char*>(out));
+        }
+
+    }
+
+    namespace detail {
+
+        decode_error decode_utc_time_general(const std::span<const std::byte> contents, asn1_time& out, const rules r) noexcept {
+            time_reader in{contents};
+            time_fields f;
+            const auto yy = in.two_digits();
+            f.month = in.two_digits();
+            f.day = in.two_digits();
+            f.hour = in.two_digits();
+            f.minute = in.two_digits();
+            const bool has_seconds = in.at_digit();
+            f.second = has_seconds ? in.two_digits() : 0;
+            if (yy < 0 || f.month < 0 || f.day < 0 || f.hour < 0 || f.minute < 0 || f.second < 0) {
+                return decode_error::invalid_time;
+            }
+            f.year = utc_year(yy);
+            bool zulu = false;
+            if (auto err = in.zone(true, f.offset, zulu); err != decode_error::none) {
+                return err;
+            }
+            else if (err = fields_to_time(f, out); err != decode_error::none) {
+                return err;
+            }
+            return r != rules::ber && (!has_seconds || !zulu) ? decode_error::non_canonical_time : decode_error::none;
+        }
+
+        decode_error decode_generalized_time_general(const std::span<const std::byte> contents, asn1_time& out, const rules r) noexcept {
+            time_reader in{contents};
+            time_fields f;
+            const auto century = in.two_digits();
+            const auto yy = in.two_digits();
+            f.month = in.two_digits();
+            f.day = in.two_digits();
+            f.hour = in.two_digits();
+            if (century < 0 || yy < 0 || f.month < 0 || f.day < 0 || f.hour < 0) {
+                return decode_error::invalid_time;
+            }
+            f.year = century * 100 + yy;
+            //The fraction, if there is one, is of the last of these there is.
+            int64_t unit = 3600;
+            if (in.at_digit()) {
+                f.minute = in.two_digits();
+                unit = 60;
+                if (f.minute >= 0 && in.at_digit()) {
+                    f.second = in.two_digits();
+                    unit = 1;
+                }
+                if (f.minute < 0 || f.second < 0) {
+                    return decode_error::invalid_time;
+                }
+            }
+            bool non_canonical = unit != 1;
+            if (in.peek() == '.' || in.peek() == ',') {
+                non_canonical |= in.peek() == ',';
+                in.next(in.peek());
+                int digits = 0;
+                bool trailing_zero = false;
+                const auto billionths = in.fraction(digits, trailing_zero);
+                if (digits == 0) {
+                    return decode_error::invalid_time;
+                }
+                non_canonical |= trailing_zero;
+                f.microseconds = billionths * unit / 1000;
+            }
+            bool zulu = false;
+            if (auto err = in.zone(false, f.offset, zulu); err != decode_error::none) {
+                return err;
+            }
+            else if (err = fields_to_time(f, out); err != decode_error::none) {
+                return err;
+            }
+            return r != rules::ber && (non_canonical || !zulu) ? decode_error::non_canonical_time : decode_error::none;
+        }
+
+    } /* namespace detail */
+
+    asn1_time decode_utc_time(const std::span<const std::byte> contents, const rules r) {
+        asn1_time retval{};
+        if (auto err = try_decode_utc_time(contents, retval, r); err != decode_error::none) {
+            throw_decode_error(err, "UTCTime");
+        }
+        return retval;
+    }
+
+    asn1_time decode_generalized_time(const std::span<const std::byte> contents, const rules r) {
+        asn1_time retval{};
+        if (auto err = try_decode_generalized_time(contents, retval, r); err != decode_error::none) {
+            throw_decode_error(err, "GeneralizedTime");
+        }
+        return retval;
+    }
+
+    std::size_t encode_utc_time(const asn1_time t, std::byte* const out) {
+        return encode_time(t, out, false, false);
+    }
+
+    std::size_t encode_generalized_time(const asn1_time t, std::byte* const out) {
+        return encode_time(t, out, true, true);
+    }
+
+    TEST_CASE("decode_utc_time and decode_generalized_time") {
+        const auto at = [](const int y, const unsigned int m, const unsigned int d, const int h, const int mi, const int s) {
+            return asn1_time{sys_days{year{y} / month{m} / day{d}}} + hours{h} + minutes{mi} + seconds{s};
+        };
+
+        SUBCASE("fixed forms") {
+            CHECK_EQ(decode_utc_time(to_bytes("230101120000Z"), rules::der), at(2023, 1, 1, 12, 0, 0));
+            CHECK_EQ(decode_utc_time(to_bytes("491231235959Z")), at(2049, 12, 31, 23, 59, 59));
+            CHECK_EQ(decode_utc_time(to_bytes("500101000000Z")), at(1950, 1, 1, 0, 0, 0));
+            CHECK_EQ(decode_utc_time(to_bytes("240229000000Z")), at(2024, 2, 29, 0, 0, 0));
+            CHECK_EQ(decode_generalized_time(to_bytes("99991231235959Z"), rules::der), at(9999, 12, 31, 23, 59, 59));
+            CHECK_EQ(decode_generalized_time(to_bytes("19691231235959Z")), at(1969, 12, 31, 23, 59, 59));
+            CHECK_EQ(decode_generalized_time(to_bytes("00000101000000Z")), at(0, 1, 1, 0, 0, 0));
+
+            asn1_time t{};
+            for (const auto* s : {"231301120000Z", "230229120000Z", "230100120000Z", "230101240000Z", "230101126000Z",
+                                  "230101120060Z", "23010112000:Z", "2301/1120000Z", "230101120000z", "23010112000 Z"}) {
+                CAPTURE(s);
+                CHECK_EQ(try_decode_utc_time(to_bytes(s), t), decode_error::invalid_time);
+            }
+            CHECK_EQ(try_decode_generalized_time(to_bytes("21000229000000Z"), t), decode_error::invalid_time);
+            CHECK_EQ(try_decode_generalized_time(to_bytes("2023010112000AZ"), t), decode_error::invalid_time);
+            CHECK_THROWS_AS(decode_utc_time(to_bytes("")), exception);
+        }
+
+        SUBCASE("other forms") {
+            asn1_time t{};
+            const auto check = [&](auto decode, const std::string_view s, const asn1_time expected) {
+                CAPTURE(s);
+                REQUIRE_EQ(decode(to_bytes(s), t, rules::ber), decode_error::none);
+                CHECK_EQ(t, expected);
+                CHECK_EQ(decode(to_bytes(s), t, rules::der), decode_error::non_canonical_time);
+            };
+            check(try_decode_utc_time, "2301011200Z", at(2023, 1, 1, 12, 0, 0));
+            check(try_decode_utc_time, "230101120000+0130", at(2023, 1, 1, 10, 30, 0));
+            check(try_decode_utc_time, "2301010000-0800", at(2023, 1, 1, 8, 0, 0));
+            check(try_decode_generalized_time, "2023010112Z", at(2023, 1, 1, 12, 0, 0));
+            check(try_decode_generalized_time, "202301011230.5Z", at(2023, 1, 1, 12, 30, 30));
+            check(try_decode_generalized_time, "2023010112.25Z", at(2023, 1, 1, 12, 15, 0));
+            check(try_decode_generalized_time, "20230101120000,25Z", at(2023, 1, 1, 12, 0, 0) + milliseconds{250});
+            check(try_decode_generalized_time, "20230101120000.50Z", at(2023, 1, 1, 12, 0, 0) + milliseconds{500});
+            check(try_decode_generalized_time, "20230101120000-08", at(2023, 1, 1, 20, 0, 0));
+            check(try_decode_generalized_time, "20230101120000+0545", at(2023, 1, 1, 6, 15, 0));
+
+            REQUIRE_EQ(try_decode_generalized_time(to_bytes("20230101120000.123456789Z"), t, rules::der), decode_error::none);
+            CHECK_EQ(t, at(2023, 1, 1, 12, 0, 0) + microseconds{123456});
+            REQUIRE_EQ(try_decode_generalized_time(to_bytes("20230101120000.5Z"), t, rules::der), decode_error::none);
+            CHECK_EQ(t, at(2023, 1, 1, 12, 0, 0) + milliseconds{500});
+
+            for (const auto* s : {"20230101120000", "20230101120000.Z", "202301011Z", "20230101120000+2400",
+                                  "20230101120000+01300", "2023010112000Z", "20230101120000ZZ"}) {
+                CAPTURE(s);
+                CHECK_EQ(try_decode_generalized_time(to_bytes(s), t), decode_error::invalid_time);
+            }
+            CHECK_EQ(try_decode_utc_time(to_bytes("230101120000+01"), t), decode_error::invalid_time);
+        }
+
+        SUBCASE("encoding") {
+            std::array<std::byte, max_encoded_time_size> buf{};
+            const auto encoded = [&](const std::size_t n) {
+                return std::string{reinterpret_cast<const char*>(buf.data()), n};
+            };
+            CHECK_EQ(encoded(encode_utc_time(at(2023, 1, 1, 12, 0, 0) + milliseconds{500}, buf.data())), "230101120000Z");
+            CHECK_EQ(encoded(encode_generalized_time(at(2023, 1, 1, 12, 0, 0), buf.data())), "20230101120000Z");
+            CHECK_EQ(encoded(encode_generalized_time(at(2023, 1, 1, 12, 0, 0) + milliseconds{500}, buf.data())), "20230101120000.5Z");
+            CHECK_EQ(encoded(encode_generalized_time(at(1969, 12, 31, 23, 59, 59) + microseconds{999999}, buf.data())), "19691231235959.999999Z");
+            CHECK_THROWS_AS(encode_utc_time(at(2050, 1, 1, 0, 0, 0), buf.data()), exception);
+            CHECK_THROWS_AS(encode_generalized_time(at(10000, 1, 1, 0, 0, 0), buf.data()), exception);
+
+            std::vector<std::byte> out;
+            write_utc_time(at(2023, 1, 1, 12, 0, 0), vector_sink{out});
+            CHECK_EQ(out, to_bytes("\x17\x0d" "230101120000Z"));
+
+            //Every encoding decodes back under DER to the same time.
+            std::mt19937_64 rng{24};
+            for (int i = 0; i < 2000; ++i) {
+                const auto g = asn1_time{sys_days{year{0} / 1 / 1}} + microseconds{static_cast<int64_t>(rng() % 315'537'897'600'000'000u)};
+                asn1_time back{};
+                REQUIRE_EQ(try_decode_generalized_time({buf.data(), encode_generalized_time(g, buf.data())}, back, rules::der), decode_error::none);
+                CHECK_EQ(back, g);
+                const auto u = asn1_time{sys_days{year{1950} / 1 / 1}} + seconds{static_cast<int64_t>(rng() % 3'155'760'000u)};
+                REQUIRE_EQ(try_decode_utc_time({buf.data(), encode_utc_time(u, buf.data())}, back, rules::der), decode_error::none);
+                CHECK_EQ(back, u);
+            }
+        }
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,171 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/tlv_view.h"
+#include "dabers/character_string.h"
+#include "dabers/codec.h"
+#include "dabers/length.h"
+#include "dabers/skip.h"
+#include "exception.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace dabers {
+
+    template <typename Rules>
+    decode_error tlv_cursor::next_as(tlv_cursor& c, tlv_element& out) noexcept {
+        using codec_type = codec<Rules>;
+        const std::byte* cur = c.m_cur;
+        tlv_header h;
+        if (auto err = codec_type::try_parse_header(cur, c.m_end, h); err != decode_error::none) {
+            return err;
+        }
+        const std::byte* after = cur + h.contents.size();
+        if (h.indefinite()) {
+            const std::byte* eoc = nullptr;
+            if (auto err = codec_type::find_end_of_contents(cur, c.m_end, eoc); err != decode_error::none) {
+                return err;
+            }
+            h.contents = {cur, static_cast<std::size_t>(eoc - cur)};
+            after = eoc + 2;
+        }
+        out = tlv_element{h, {c.m_cur, static_cast<std::size_t>(after - c.m_cur)}, codec_type::runtime_rules};
+        c.m_cur = after;
+        return decode_error::none;
+    }
+
+    tlv_cursor::next_fn tlv_cursor::next_for(const rules r) noexcept {
+        return with_codec(r, [](auto c) -> next_fn { return &next_as<typename decltype(c)::rules_type>; });
+    }
+
+    template decode_error tlv_cursor::next_as<ber>(tlv_cursor& c, tlv_element& out) noexcept;
+    template decode_error tlv_cursor::next_as<cer>(tlv_cursor& c, tlv_element& out) noexcept;
+    template decode_error tlv_cursor::next_as<der>(tlv_cursor& c, tlv_element& out) noexcept;
+
+    decode_error tlv_element::try_to_utf8(const std::span<char> out, std::size_t& written) const noexcept {
+        return try_string_to_utf8(id(), contents(), out, written);
+    }
+
+    std::string tlv_element::to_utf8() const {
+        return string_to_utf8(id(), contents());
+    }
+
+    tlv_view::iterator& tlv_view::iterator::operator++() {
+        if (m_cursor.done()) {
+            m_at_end = true;
+            m_current = {};
+        }
+        else if (auto err = m_cursor.next(m_current); err != decode_error::none) {
+            throw_decode_error(err, "element");
+        }
+        else {
+            m_at_end = false;
+        }
+        return *this;
+    }
+
+    static_assert(std::forward_iterator<tlv_view::iterator>);
+    static_assert(std::ranges::forward_range<tlv_view>);
+    static_assert(std::ranges::borrowed_range<tlv_view>);
+
+    TEST_CASE("tlv_view iteration") {
+        const auto buf = sample_document();
+        tlv_view top{buf};
+        CHECK_EQ(std::ranges::distance(top), 2);
+
+        auto it = top.begin();
+        REQUIRE(it != top.end());
+        CHECK_EQ(it->id(), tag{tag_class_type::universal, true, 16});
+        CHECK_FALSE(it->indefinite());
+        CHECK_EQ(it->header_size(), 2u);
+        CHECK_EQ(it->encoded().size(), 18u);
+        CHECK_EQ(it->contents().data(), buf.data() + 2);
+        CHECK_EQ(it->contents().size(), 16u);
+
+        auto children = it->children();
+        std::vector<uint64_t> numbers;
+        for (const auto& e : children) {
+            numbers.push_back(e.id().tag_number);
+        }
+        CHECK_EQ(numbers, std::vector<uint64_t>{2, 16, 1});
+
+        auto inner = std::ranges::find_if(children, [](const tlv_element& e){ return e.id().tag_number == 16; });
+        REQUIRE(inner != children.end());
+        CHECK(inner->indefinite());
+        CHECK_EQ(inner->contents().size(), 6u);
+        CHECK_EQ(inner->encoded().size(), 10u);
+        auto grandchildren = inner->children();
+        auto gc = grandchildren.begin();
+        CHECK_EQ(gc->id(), tag{tag_class_type::universal, false, 4});
+        CHECK_EQ(gc->contents().size(), 2u);
+        CHECK_EQ(gc->contents()[0], std::byte{0x61u});
+        ++gc;
+        CHECK_EQ(gc->id(), tag{tag_class_type::context_specific, true, 0});
+        CHECK(gc->contents().empty());
+        CHECK(gc->children().empty());
+        ++gc;
+        CHECK(gc == grandchildren.end());
+
+        ++it;
+        CHECK_EQ(it->id(), tag{tag_class_type::universal, false, 5});
+        CHECK(it->children().empty());
+        ++it;
+        CHECK(it == top.end());
+        CHECK(tlv_view{}.begin() == tlv_view{}.end());
+
+        //The end-of-contents octets of an indefinite length element inside another are
+        //  skipped over when looking for the outer one's.
+        const auto nested = to_bytes({0x30u, 0x80u, 0xa0u, 0x80u, 0x00u, 0x00u, 0x00u, 0x00u});
+        const auto outer = *tlv_view{nested}.begin();
+        CHECK_EQ(outer.contents().size(), 4u);
+        CHECK_EQ(outer.encoded().size(), nested.size());
+        CHECK(outer.children().begin()->contents().empty());
+    }
+
+    TEST_CASE("tlv_element to_utf8") {
+        //BMPString "Zü", UTF8String "ab", OCTET STRING "ab"
+        auto buf = to_bytes({0x1eu, 0x04u, 0x00u, 0x5au, 0x00u, 0xfcu,
+                             0x0cu, 0x02u, 0x61u, 0x62u,
+                             0x04u, 0x02u, 0x61u, 0x62u});
+        tlv_view elements{buf};
+        auto it = elements.begin();
+        CHECK_EQ(it->to_utf8(), "Z\xc3\xbc");
+        ++it;
+        std::array<char, 2> out{};
+        std::size_t written = 0;
+        CHECK_EQ(it->try_to_utf8(out, written), decode_error::none);
+        CHECK_EQ(std::string_view{out.data(), written}, "ab");
+        ++it;
+        CHECK_EQ(it->try_to_utf8(out, written), decode_error::unsupported_string_type);
+        CHECK_THROWS_AS(it->to_utf8(), exception);
+    }
+
+    TEST_CASE("tlv_cursor failures") {
+        //Missing end-of-contents octets.
+        auto buf = to_bytes({0x30u, 0x80u, 0x02u, 0x01u, 0x05u});
+        tlv_cursor c{buf};
+        tlv_element e;
+        CHECK_EQ(c.next(e), decode_error::buffer_too_small);
+        CHECK_EQ(c.remaining().data(), buf.data());
+        CHECK_THROWS_AS(static_cast<void>(tlv_view{buf}.begin()), exception);
+
+        //DER doesn't allow the indefinite form at all.
+        buf = to_bytes({0x30u, 0x80u, 0x00u, 0x00u});
+        c = tlv_cursor{buf, rules::der};
+        CHECK_EQ(c.next(e), decode_error::indefinite_length_forbidden);
+
+        //Truncated second element.
+        buf = to_bytes({0x02u, 0x01u, 0x05u, 0x04u, 0x05u, 0x00u});
+        tlv_view v{buf};
+        auto it = v.begin();
+        CHECK_THROWS_AS(++it, exception);
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,143 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/tree.h"
+#include "dabers/character_string.h"
+#include "dabers/codec.h"
+#include "dabers/header.h"
+#include "element_walk.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <ranges>
+
+namespace dabers {
+
+    decode_error tree_node::try_to_utf8(const std::span<char> out, std::size_t& written) const noexcept {
+        return try_string_to_utf8(id, contents, out, written);
+    }
+
+    std::string tree_node::to_utf8() const {
+        return string_to_utf8(id, contents);
+    }
+
+    decode_error tree::decode(node_arena& arena, const std::span<const std::byte> document, const rules r, tree& out) {
+        return with_codec(r, [&](auto c){ return decode_with<decltype(c)>(arena, document, out); });
+    }
+
+    template <typename Codec>
+    decode_error tree::decode_with(node_arena& arena, const std::span<const std::byte> document, tree& out) {
+        static_assert(tree_node::npos == detail::no_element);
+        auto& nodes = arena.m_nodes;
+        const auto first = nodes.size();
+
+        auto on_element = [&nodes](const tlv_header& h, const std::byte*, uint32_t index, uint32_t parent, uint32_t prev_sibling) {
+            if (prev_sibling != tree_node::npos) {
+                nodes[prev_sibling].next_sibling = index;
+            }
+            else if (parent != tree_node::npos) {
+                nodes[parent].first_child = index;
+            }
+            nodes.push_back({h.id,
+                             h.contents,
+                             parent,
+                             tree_node::npos,
+                             tree_node::npos,
+                             static_cast<uint8_t>(h.header_size),
+                             h.indefinite()});
+            return decode_error::none;
+        };
+        auto on_end_of_contents = [&nodes](uint32_t index, const std::byte* eoc) {
+            auto& n = nodes[index];
+            n.contents = {n.contents.data(), static_cast<std::size_t>(eoc - n.contents.data())};
+        };
+        if (auto err = detail::walk_elements<Codec>(document, arena.m_open, static_cast<uint32_t>(first), on_element, on_end_of_contents);
+            err != decode_error::none) {
+            nodes.resize(first);
+            return err;
+        }
+
+        out.m_arena = &arena;
+        out.m_first = static_cast<uint32_t>(first);
+        out.m_last = static_cast<uint32_t>(nodes.size());
+        return decode_error::none;
+    }
+
+    uint32_t tree::find_child(const uint32_t i, const tag& t) const noexcept {
+        for (auto it = children(i).begin(); it != sibling_iterator{}; ++it) {
+            if (it->id == t) {
+                return it.index();
+            }
+        }
+        return tree_node::npos;
+    }
+
+    static_assert(std::forward_iterator<tree::sibling_iterator>);
+    static_assert(std::ranges::forward_range<tree::sibling_range>);
+
+    TEST_CASE("tree decode") {
+        const auto buf = sample_document();
+        node_arena arena;
+        tree t;
+        REQUIRE_EQ(tree::decode(arena, buf, rules::ber, t), decode_error::none);
+        REQUIRE_EQ(t.size(), 7u);
+        CHECK_EQ(std::ranges::distance(t.roots()), 2);
+
+        const auto root = t.root();
+        CHECK_EQ(t[root].id, tag{tag_class_type::universal, true, 16});
+        CHECK_EQ(t[root].contents.size(), 16u);
+        std::vector<uint64_t> numbers;
+        for (const auto& n : t.children(root)) {
+            numbers.push_back(n.id.tag_number);
+        }
+        CHECK_EQ(numbers, std::vector<uint64_t>{2, 16, 1});
+
+        const auto inner = t.find_child(root, {tag_class_type::universal, true, 16});
+        REQUIRE_NE(inner, tree_node::npos);
+        CHECK(t[inner].indefinite);
+        CHECK_EQ(t[inner].contents.size(), 6u);
+        CHECK_EQ(t[inner].parent, root);
+        const auto octets = t[inner].first_child;
+        CHECK_EQ(t[octets].contents[1], std::byte{0x62u});
+        CHECK(t.children(t[octets].next_sibling).empty());
+        std::array<char, 8> chars{};
+        std::size_t written = 0;
+        CHECK_EQ(t[octets].try_to_utf8(chars, written), decode_error::unsupported_string_type);
+        CHECK_EQ(t.find_child(root, {tag_class_type::universal, false, 4}), tree_node::npos);
+
+        //Decoding more into the same arena leaves the first tree alone.
+        tree t2;
+        REQUIRE_EQ(tree::decode(arena, std::span{buf}.subspan(18), rules::ber, t2), decode_error::none);
+        CHECK_EQ(t2.size(), 1u);
+        CHECK_EQ(t2.root(), 7u);
+        CHECK_EQ(t[root].id, tag{tag_class_type::universal, true, 16});
+
+        //After a reset the storage is reused.
+        const auto capacity = arena.capacity();
+        arena.reset();
+        REQUIRE_EQ(tree::decode(arena, buf, rules::ber, t), decode_error::none);
+        CHECK_EQ(arena.capacity(), capacity);
+        CHECK_EQ(t.root(), 0u);
+    }
+
+    TEST_CASE("tree decode failures") {
+        node_arena arena;
+        tree t;
+        auto good = to_bytes({0x05u, 0x00u});
+        REQUIRE_EQ(tree::decode(arena, good, rules::ber, t), decode_error::none);
+
+        auto buf = to_bytes({0x30u, 0x80u, 0x02u, 0x01u, 0x05u});
+        CHECK_EQ(tree::decode(arena, buf, rules::ber, t), decode_error::buffer_too_small);
+        CHECK_EQ(arena.size(), 1u);
+        buf = to_bytes({0x30u, 0x03u, 0x02u, 0x02u, 0x05u, 0x06u});
+        CHECK_EQ(tree::decode(arena, buf, rules::ber, t), decode_error::buffer_too_small);
+        buf = to_bytes({0x30u, 0x80u, 0x00u, 0x00u});
+        CHECK_EQ(tree::decode(arena, buf, rules::der, t), decode_error::indefinite_length_forbidden);
+        CHECK_EQ(arena.size(), 1u);
+    }
+
+} /* namespace dabers */
@@ -0,0 +1,336 @@
+//
+// Created by Daniel Garcia on 10/17/2026.
+//
+
+#include "dabers/validate.h"
+#include "dabers/codec.h"
+#include "dabers/der_set_of.h"
+#include "dabers/header.h"
+#include "dabers/integer.h"
+#include "dabers/tag.h"
+#include "test_util.h"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace dabers {
+
+    namespace {
+
+        constexpr uint32_t bit(const unsigned int n) noexcept {
+            return uint32_t{1} << n;
+        }
+
+        /**
+         * The universal types which are primitive under every set of rules:  BOOLEAN, INTEGER,
+         * NULL, OBJECT IDENTIFIER, REAL, ENUMERATED, RELATIVE-OID, TIME and DATE.
+         */
+        constexpr uint32_t PRIMITIVE_TYPES = bit(1) | bit(2) | bit(5) | bit(6) | bit(9) | bit(10) | bit(13) | bit(14) | bit(31);
+
+        /**
+         * The universal types BER lets be constructed from segments but DER doesn't:  BIT
+         * STRING, OCTET STRING, ObjectDescriptor, the character strings and the times.
+         */
+        constexpr uint32_t STRING_TYPES = bit(3) | bit(4) | bit(7) | bit(12) | 0x7ffc0000u;
+
+        /**
+         * EXTERNAL, EMBEDDED PDV, SEQUENCE and SET.
+         */
+        constexpr uint32_t CONSTRUCTED_TYPES = bit(8) | bit(11) | bit(16) | bit(17);
+
+        static_assert((PRIMITIVE_TYPES & STRING_TYPES) == 0 && (STRING_TYPES & CONSTRUCTED_TYPES) == 0);
+
+        /**
+         * The checks on a single element which don't depend on its neighbours.
+         */
+        template <typename Rules>
+        decode_error check_element(const tag& t, const std::byte* const contents, const std::size_t size) noexcept {
+            constexpr bool is_der = std::same_as<Rules, der>;
+            if (t.tag_class != tag_class_type::universal || t.tag_number >= 32) {
+                return decode_error::none;
+            }
+            const auto type = bit(static_cast<unsigned int>(t.tag_number));
+            if (t.tag_number == 0) {
+                //Only ever end-of-contents octets, which are handled before getting here.
+                return decode_error::unexpected_end_of_contents;
+            }
+            else if (t.constructed) {
+                return (type & PRIMITIVE_TYPES) != 0 || (is_der && (type & STRING_TYPES) != 0) ?
+                       decode_error::primitive_encoding_required : decode_error::none;
+            }
+            else if ((type & CONSTRUCTED_TYPES) != 0) {
+                return decode_error::constructed_encoding_required;
+            }
+            switch (t.tag_number) {
+                case universal_tags::boolean::value.tag_number:
+                    if (size != 1 || (is_der && contents[0] != std::byte{0} && contents[0] != std::byte{0xffu})) {
+                        return decode_error::invalid_boolean;
+                    }
+                    break;
+                case universal_tags::integer::value.tag_number:
+                case universal_tags::enumerated::value.tag_number:
+                    return detail::check_integer({contents, size});
+                case universal_tags::null::value.tag_number:
+                    if (size != 0) {
+                        return decode_error::invalid_null;
+                    }
+                    break;
+                case universal_tags::bit_string::value.tag_number: {
+                    //The first octet is the number of unused bits in the last, which there
+                    //  can't be any of without a last octet.
+                    if (size == 0) {
+                        return decode_error::invalid_bit_string;
+                    }
+                    const auto unused = std::to_integer<unsigned int>(contents[0]);
+                    if (unused > 7 || (size == 1 && unused != 0) ||
+                        (is_der && (std::to_integer<unsigned int>(contents[size - 1]) & ((1u << unused) - 1u)) != 0)) {
+                        return decode_error::invalid_bit_string;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            return decode_error::none;
+        }
+
+        /**
+         * Whether a is no greater than b in the SET OF order:  compared octet by octet, with
+         * the shorter padded with trailing zeros (X.690 11.6).  One whole encoding can't start
+         * with another, since the length octets say where each ends, so the padding never
+         * gets compared and equal prefixes mean equal encodings.
+         */
+        bool set_of_ordered(const std::byte* const a, const std::size_t a_size, const std::byte* const b, const std::size_t b_size) noexcept {
+            return std::memcmp(a, b, std::min(a_size, b_size)) <= 0;
+        }
+
+        /**
+         * Whether a comes strictly before b in the canonical tag order of a SET (X.680 8.6):
+         * by class, universal first, then by number.
+         */
+        bool set_ordered(const tag_class_type a_class, const uint64_t a_number, const tag& b) noexcept {
+            return a_class != b.tag_class ? a_class < b.tag_class : a_number < b.tag_number;
+        }
+
+        struct open_element {
+            /**
+             * The end of the contents for definite lengths, otherwise the end of the nearest
+             * enclosing definite length element (or the document).
+             */
+            const std::byte* end;
+            bool indefinite;
+            /**
+             * For a DER SET, the previous component and which of the two orders the
+             * components so far are in.
+             */
+            bool set;
+            bool by_tag;
+            bool by_encoding;
+            const std::byte* prev;
+            std::size_t prev_size;
+            //Not a tag, which would have every entry of the stack initialized up front.
+            tag_class_type prev_class;
+            uint64_t prev_number;
+        };
+
+        template <typename Rules>
+        validation_result validate_with(const std::span<const std::byte> document) noexcept {
+            constexpr bool is_der = std::same_as<Rules, der>;
+            const std::byte* const begin = document.data();
+            const std::byte* const end = begin + document.size();
+            const std::byte* cur = begin;
+            std::array<open_element, max_validate_depth> open;
+            std::size_t depth = 0;
+            tlv_header h;
+
+            while (true) {
+                //Close any definite length elements we've reached the end of.
+                while (depth != 0 && !open[depth - 1].indefinite && open[depth - 1].end == cur) {
+                    --depth;
+                }
+                const std::byte* const limit = depth == 0 ? end : open[depth - 1].end;
+                const auto offset = static_cast<uint64_t>(cur - begin);
+                if (cur == limit) {
+                    if (depth != 0) {
+                        //An indefinite length element without its end-of-contents octets.
+                        return {decode_error::buffer_too_small, offset};
+                    }
+                    return {};
+                }
+                else if (depth != 0 && open[depth - 1].indefinite &&
+                         limit - cur >= 2 && cur[0] == std::byte{0} && cur[1] == std::byte{0}) {
+                    cur += 2;
+                    --depth;
+                    continue;
+                }
+
+                const std::byte* const element = cur;
+                const auto& first = detail::identifier_octet_table[std::to_integer<std::size_t>(cur[0])];
+                if (!first.long_form && limit - cur >= 2 && cur[1] < std::byte{0x80u}) {
+                    //A low tag number and a short form length, which is almost everything and
+                    //  always minimal.
+                    const auto len = std::to_integer<std::size_t>(cur[1]);
+                    if (static_cast<std::size_t>(limit - cur) - 2 < len) {
+                        return {decode_error::buffer_too_small, offset};
+                    }
+                    h.id = {first.tag_class, first.constructed, first.tag_number};
+                    h.length = len;
+                    h.header_size = 2;
+                    cur += 2;
+                }
+                else if (auto err = dabers::try_parse_header(Rules{}, cur, limit, h); err != decode_error::none) {
+                    return {err, offset};
+                }
+                else if (err = codec<Rules>::validate_header(h); err != decode_error::none) {
+                    return {err, offset};
+                }
+                const auto size = h.length.value_or(0);
+
+                if (auto err = check_element<Rules>(h.id, cur, size); err != decode_error::none) {
+                    return {err, offset};
+                }
+                if constexpr (is_der) {
+                    if (depth != 0 && open[depth - 1].set) {
+                        auto& parent = open[depth - 1];
+                        const auto encoded_size = h.header_size + size;
+                        if (parent.prev != nullptr) {
+                            parent.by_tag = parent.by_tag && set_ordered(parent.prev_class, parent.prev_number, h.id);
+                            parent.by_encoding = parent.by_encoding && set_of_ordered(parent.prev, parent.prev_size, element, encoded_size);
+                            if (!parent.by_tag && !parent.by_encoding) {
+                                return {decode_error::set_out_of_order, offset};
+                            }
+                        }
+                        parent.prev = element;
+                        parent.prev_size = encoded_size;
+                        parent.prev_class = h.id.tag_class;
+                        parent.prev_number = h.id.tag_number;
+                    }
+                }
+
+                if (h.id.constructed) {
+                    if (depth == open.size()) {
+                        return {decode_error::nesting_too_deep, offset};
+                    }
+                    const bool set = is_der && h.id.tag_class == tag_class_type::universal &&
+                                     h.id.tag_number == universal_tags::set::value.tag_number;
+                    open[depth++] = {h.indefinite() ? limit : cur + size, h.indefinite(), set, true, true, nullptr, 0, tag_class_type::universal, 0};
+                }
+                else {
+                    cur += size;
+                }
+            }
+        }
+
+    }
+
+    template <typename Rules>
+        requires std::same_as<Rules, ber> || std::same_as<Rules, der>
+    validation_result validate(const std::span<const std::byte> document) noexcept {
+        return validate_with<Rules>(document);
+    }
+
+    template validation_result validate<ber>(std::span<const std::byte> document) noexcept;
+    template validation_result validate<der>(std::span<const std::byte> document) noexcept;
+
+    TEST_CASE("validate") {
+        const auto der_result = [](const std::vector<unsigned int>& v) { return validate<der>(to_bytes(v)); };
+        const auto ber_result = [](const std::vector<unsigned int>& v) { return validate<ber>(to_bytes(v)); };
+        const auto check_fails = [&](const std::vector<unsigned int>& v, const decode_error err, const uint64_t offset, const bool ber_ok) {
+            const auto r = der_result(v);
+            CHECK_EQ(r.error, err);
+            CHECK_EQ(r.offset, offset);
+            CHECK_EQ(ber_result(v).ok(), ber_ok);
+        };
+
+        const auto der_document = sample_der_document();
+        CHECK(validate<der>(der_document).ok());
+        CHECK(validate<ber>(der_document).ok());
+        const auto ber_document = sample_document();
+        CHECK(validate<ber>(ber_document).ok());
+        CHECK_EQ(validate<der>(ber_document).error, decode_error::indefinite_length_forbidden);
+        CHECK_EQ(validate<der>(ber_document).offset, 5u);
+        CHECK(der_result({}).ok());
+
+        SUBCASE("headers") {
+            //A long form length which fits in the short form, and indefinite lengths.
+            check_fails({0x30u, 0x81u, 0x03u, 0x02u, 0x01u, 0x05u}, decode_error::non_minimal_length, 0, true);
+            check_fails({0x30u, 0x04u, 0x04u, 0x81u, 0x01u, 0x61u}, decode_error::non_minimal_length, 2, true);
+            check_fails({0x30u, 0x80u, 0x02u, 0x01u, 0x05u, 0x00u, 0x00u}, decode_error::indefinite_length_forbidden, 0, true);
+            check_fails({0x1fu, 0x1eu, 0x00u}, decode_error::tag_number_too_small, 0, false);
+            //A child running past its parent, a parent with a partial child, and a truncated document.
+            check_fails({0x30u, 0x03u, 0x02u, 0x02u, 0x05u, 0x06u}, decode_error::buffer_too_small, 2, false);
+            check_fails({0x30u, 0x03u, 0x02u, 0x01u, 0x05u, 0x05u}, decode_error::buffer_too_small, 5, false);
+            check_fails({0x02u, 0x02u, 0x05u}, decode_error::buffer_too_small, 0, false);
+            check_fails({0x30u, 0x02u, 0x00u, 0x00u}, decode_error::unexpected_end_of_contents, 2, false);
+            CHECK(ber_result({0x30u, 0x80u, 0x02u, 0x01u, 0x05u, 0x00u, 0x00u, 0x05u, 0x00u}).ok());
+            CHECK_EQ(ber_result({0x30u, 0x80u, 0x02u, 0x01u, 0x05u}).error, decode_error::buffer_too_small);
+
+            std::vector<unsigned int> deep;
+            for (std::size_t i = 0; i <= max_validate_depth; ++i) {
+                deep.insert(deep.end(), {0x30u, 0x80u});
+            }
+            CHECK_EQ(ber_result(deep).error, decode_error::nesting_too_deep);
+        }
+
+        SUBCASE("values") {
+            check_fails({0x01u, 0x01u, 0x01u}, decode_error::invalid_boolean, 0, true);
+            check_fails({0x01u, 0x02u, 0x00u, 0x00u}, decode_error::invalid_boolean, 0, false);
+            check_fails({0x02u, 0x02u, 0x00u, 0x05u}, decode_error::non_minimal_integer, 0, false);
+            check_fails({0x0au, 0x00u}, decode_error::empty_integer, 0, false);
+            check_fails({0x05u, 0x01u, 0x00u}, decode_error::invalid_null, 0, false);
+            check_fails({0x03u, 0x02u, 0x01u, 0x81u}, decode_error::invalid_bit_string, 0, true);
+            check_fails({0x03u, 0x01u, 0x01u}, decode_error::invalid_bit_string, 0, false);
+            check_fails({0x03u, 0x02u, 0x08u, 0x00u}, decode_error::invalid_bit_string, 0, false);
+            check_fails({0x03u, 0x00u}, decode_error::invalid_bit_string, 0, false);
+            CHECK(der_result({0x03u, 0x02u, 0x07u, 0x80u}).ok());
+            //Context specific tags are left alone.
+            CHECK(der_result({0x81u, 0x02u, 0x00u, 0x05u}).ok());
+        }
+
+        SUBCASE("forms") {
+            check_fails({0x24u, 0x04u, 0x04u, 0x02u, 0x61u, 0x62u}, decode_error::primitive_encoding_required, 0, true);
+            check_fails({0x30u, 0x05u, 0x33u, 0x03u, 0x13u, 0x01u, 0x61u}, decode_error::primitive_encoding_required, 2, true);
+            check_fails({0x22u, 0x03u, 0x02u, 0x01u, 0x05u}, decode_error::primitive_encoding_required, 0, false);
+            check_fails({0x10u, 0x00u}, decode_error::constructed_encoding_required, 0, false);
+            check_fails({0x11u, 0x00u}, decode_error::constructed_encoding_required, 0, false);
+        }
+
+        SUBCASE("set ordering") {
+            //SET OF INTEGER, in and out of order.
+            CHECK(der_result({0x31u, 0x09u, 0x02u, 0x01u, 0x01u, 0x02u, 0x01u, 0x01u, 0x02u, 0x01u, 0x05u}).ok());
+            check_fails({0x31u, 0x09u, 0x02u, 0x01u, 0x01u, 0x02u, 0x01u, 0x05u, 0x02u, 0x01u, 0x02u},
+                        decode_error::set_out_of_order, 8, true);
+            CHECK(der_result({0x31u, 0x07u, 0x02u, 0x01u, 0x05u, 0x04u, 0x00u, 0x04u, 0x00u}).ok());
+            check_fails({0x31u, 0x06u, 0x04u, 0x01u, 0x62u, 0x04u, 0x01u, 0x61u}, decode_error::set_out_of_order, 5, true);
+            //A SET in tag order, whose encodings aren't in order, and one in neither.
+            CHECK(der_result({0x31u, 0x07u, 0xa0u, 0x00u, 0x81u, 0x00u, 0x82u, 0x01u, 0x00u}).ok());
+            check_fails({0x31u, 0x04u, 0xa1u, 0x00u, 0x80u, 0x00u}, decode_error::set_out_of_order, 4, true);
+            //SEQUENCEs and sets inside other sets are checked on their own.
+            CHECK(der_result({0x30u, 0x06u, 0x04u, 0x01u, 0x62u, 0x04u, 0x01u, 0x61u}).ok());
+            check_fails({0x31u, 0x0du, 0x31u, 0x03u, 0x02u, 0x01u, 0x01u, 0x31u, 0x06u, 0x02u, 0x01u, 0x05u, 0x02u, 0x01u, 0x02u},
+                        decode_error::set_out_of_order, 12, true);
+        }
+
+        SUBCASE("encoder output") {
+            std::mt19937_64 rng{25};
+            for (int i = 0; i < 200; ++i) {
+                der_set_of set;
+                der_encoder enc;
+                for (auto n = rng() % 8; n > 0; --n) {
+                    std::vector<std::byte> component;
+                    vector_sink sink{component};
+                    write_integer(static_cast<int64_t>(rng()) >> (rng() % 64), sink);
+                    set.add(component);
+                }
+                set.write(enc);
+                CHECK_EQ(validate<der>(enc.data()).error, decode_error::none);
+            }
+        }
+    }
+
+} /* namespace dabers */